@@ -29,4 +29,129 @@ const char* RUBY_HAVERSINE_DISTANCE =
     "    EARTH_RADIUS * angular_distance\n"
     "end";
 
+const char* JS_VINCENTY_DISTANCE =
+    "(a_lat, a_long, b_lat, b_long) => {\n"
+    "    const SEMI_MAJOR_AXIS = 6378137.0;\n"
+    "    const FLATTENING = 1 / 298.257223563;\n"
+    "    const SEMI_MINOR_AXIS = (1 - FLATTENING) * SEMI_MAJOR_AXIS;\n"
+    "    const l = (b_long - a_long) * Math.PI / 180;\n"
+    "    const u1 = Math.atan((1 - FLATTENING) * Math.tan(a_lat * Math.PI / "
+    "180));\n"
+    "    const u2 = Math.atan((1 - FLATTENING) * Math.tan(b_lat * Math.PI / "
+    "180));\n"
+    "    const sin_u1 = Math.sin(u1), cos_u1 = Math.cos(u1);\n"
+    "    const sin_u2 = Math.sin(u2), cos_u2 = Math.cos(u2);\n"
+    "    let lambda = l;\n"
+    "    let sin_sigma, cos_sigma, sigma, cos_sq_alpha, cos_2_sigma_m;\n"
+    "    for (let i = 0;; i++) {\n"
+    "        if (i === 200) return NaN;\n"
+    "        const sin_lambda = Math.sin(lambda), cos_lambda = "
+    "Math.cos(lambda);\n"
+    "        sin_sigma = Math.sqrt((cos_u2 * sin_lambda) ** 2 +\n"
+    "            (cos_u1 * sin_u2 - sin_u1 * cos_u2 * cos_lambda) ** 2);\n"
+    "        if (sin_sigma === 0) return 0;\n"
+    "        cos_sigma = sin_u1 * sin_u2 + cos_u1 * cos_u2 * cos_lambda;\n"
+    "        sigma = Math.atan2(sin_sigma, cos_sigma);\n"
+    "        const sin_alpha = cos_u1 * cos_u2 * sin_lambda / sin_sigma;\n"
+    "        cos_sq_alpha = 1 - sin_alpha * sin_alpha;\n"
+    "        cos_2_sigma_m = cos_sq_alpha !== 0 ?\n"
+    "            cos_sigma - 2 * sin_u1 * sin_u2 / cos_sq_alpha : 0;\n"
+    "        const c = FLATTENING / 16 * cos_sq_alpha *\n"
+    "            (4 + FLATTENING * (4 - 3 * cos_sq_alpha));\n"
+    "        const previous_lambda = lambda;\n"
+    "        lambda = l + (1 - c) * FLATTENING * sin_alpha * (sigma + c * "
+    "sin_sigma *\n"
+    "            (cos_2_sigma_m + c * cos_sigma * (-1 + 2 * cos_2_sigma_m * "
+    "cos_2_sigma_m)));\n"
+    "        if (Math.abs(lambda - previous_lambda) < 1e-12) break;\n"
+    "    }\n"
+    "    const u_sq = cos_sq_alpha * (SEMI_MAJOR_AXIS ** 2 - SEMI_MINOR_AXIS "
+    "** 2) /\n"
+    "        SEMI_MINOR_AXIS ** 2;\n"
+    "    const a = 1 + u_sq / 16384 * (4096 + u_sq * (-768 + u_sq * (320 - "
+    "175 * u_sq)));\n"
+    "    const b = u_sq / 1024 * (256 + u_sq * (-128 + u_sq * (74 - 47 * "
+    "u_sq)));\n"
+    "    const delta_sigma = b * sin_sigma * (cos_2_sigma_m + b / 4 *\n"
+    "        (cos_sigma * (-1 + 2 * cos_2_sigma_m ** 2) -\n"
+    "         b / 6 * cos_2_sigma_m * (-3 + 4 * sin_sigma ** 2) *\n"
+    "         (-3 + 4 * cos_2_sigma_m ** 2)));\n"
+    "    return SEMI_MINOR_AXIS * a * (sigma - delta_sigma) / 1000;\n"
+    "}";
+
+const char* RUBY_VINCENTY_DISTANCE =
+    "SEMI_MAJOR_AXIS = 6378137.0 unless defined?(SEMI_MAJOR_AXIS)\n"
+    "FLATTENING = 1 / 298.257223563 unless defined?(FLATTENING)\n"
+    "SEMI_MINOR_AXIS = (1 - FLATTENING) * SEMI_MAJOR_AXIS unless "
+    "defined?(SEMI_MINOR_AXIS)\n"
+    "->(a_lat, a_long, b_lat, b_long) do\n"
+    "    l = (b_long - a_long) * Math::PI / 180\n"
+    "    u1 = Math::atan((1 - FLATTENING) * Math::tan(a_lat * Math::PI / "
+    "180))\n"
+    "    u2 = Math::atan((1 - FLATTENING) * Math::tan(b_lat * Math::PI / "
+    "180))\n"
+    "    sin_u1, cos_u1 = Math::sin(u1), Math::cos(u1)\n"
+    "    sin_u2, cos_u2 = Math::sin(u2), Math::cos(u2)\n"
+    "    lambda = l\n"
+    "    sin_sigma = cos_sigma = sigma = cos_sq_alpha = cos_2_sigma_m = nil\n"
+    "    i = 0\n"
+    "    loop do\n"
+    "        return Float::NAN if i == 200\n"
+    "        i += 1\n"
+    "        sin_lambda, cos_lambda = Math::sin(lambda), Math::cos(lambda)\n"
+    "        sin_sigma = Math::sqrt((cos_u2 * sin_lambda) ** 2 +\n"
+    "            (cos_u1 * sin_u2 - sin_u1 * cos_u2 * cos_lambda) ** 2)\n"
+    "        return 0.0 if sin_sigma == 0\n"
+    "        cos_sigma = sin_u1 * sin_u2 + cos_u1 * cos_u2 * cos_lambda\n"
+    "        sigma = Math::atan2(sin_sigma, cos_sigma)\n"
+    "        sin_alpha = cos_u1 * cos_u2 * sin_lambda / sin_sigma\n"
+    "        cos_sq_alpha = 1 - sin_alpha * sin_alpha\n"
+    "        cos_2_sigma_m = cos_sq_alpha != 0 ?\n"
+    "            cos_sigma - 2 * sin_u1 * sin_u2 / cos_sq_alpha : 0.0\n"
+    "        c = FLATTENING / 16 * cos_sq_alpha *\n"
+    "            (4 + FLATTENING * (4 - 3 * cos_sq_alpha))\n"
+    "        previous_lambda = lambda\n"
+    "        lambda = l + (1 - c) * FLATTENING * sin_alpha * (sigma + c * "
+    "sin_sigma *\n"
+    "            (cos_2_sigma_m + c * cos_sigma * (-1 + 2 * cos_2_sigma_m * "
+    "cos_2_sigma_m)))\n"
+    "        break if (lambda - previous_lambda).abs < 1e-12\n"
+    "    end\n"
+    "    u_sq = cos_sq_alpha * (SEMI_MAJOR_AXIS ** 2 - SEMI_MINOR_AXIS ** 2) "
+    "/\n"
+    "        SEMI_MINOR_AXIS ** 2\n"
+    "    a = 1 + u_sq / 16384 * (4096 + u_sq * (-768 + u_sq * (320 - 175 * "
+    "u_sq)))\n"
+    "    b = u_sq / 1024 * (256 + u_sq * (-128 + u_sq * (74 - 47 * u_sq)))\n"
+    "    delta_sigma = b * sin_sigma * (cos_2_sigma_m + b / 4 *\n"
+    "        (cos_sigma * (-1 + 2 * cos_2_sigma_m ** 2) -\n"
+    "         b / 6 * cos_2_sigma_m * (-3 + 4 * sin_sigma ** 2) *\n"
+    "         (-3 + 4 * cos_2_sigma_m ** 2)))\n"
+    "    SEMI_MINOR_AXIS * a * (sigma - delta_sigma) / 1000\n"
+    "end";
+
+const char* JS_INITIAL_BEARING =
+    "(a_lat, a_long, b_lat, b_long) => {\n"
+    "    const a_lat_radians = a_lat * Math.PI / 180;\n"
+    "    const b_lat_radians = b_lat * Math.PI / 180;\n"
+    "    const delta_long_radians = (b_long - a_long) * Math.PI / 180;\n"
+    "    const y = Math.sin(delta_long_radians) * Math.cos(b_lat_radians);\n"
+    "    const x = Math.cos(a_lat_radians) * Math.sin(b_lat_radians) -\n"
+    "        Math.sin(a_lat_radians) * Math.cos(b_lat_radians) *\n"
+    "        Math.cos(delta_long_radians);\n"
+    "    return (Math.atan2(y, x) * 180 / Math.PI + 360) % 360;\n"
+    "}";
+
+const char* RUBY_INITIAL_BEARING =
+    "->(a_lat, a_long, b_lat, b_long) do\n"
+    "    a_lat_radians = a_lat * Math::PI / 180\n"
+    "    b_lat_radians = b_lat * Math::PI / 180\n"
+    "    delta_long_radians = (b_long - a_long) * Math::PI / 180\n"
+    "    y = Math::sin(delta_long_radians) * Math::cos(b_lat_radians)\n"
+    "    x = Math::cos(a_lat_radians) * Math::sin(b_lat_radians) -\n"
+    "        Math::sin(a_lat_radians) * Math::cos(b_lat_radians) *\n"
+    "        Math::cos(delta_long_radians)\n"
+    "    (Math::atan2(y, x) * 180 / Math::PI + 360) % 360\n"
+    "end";
+
 #endif
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 
 #include "libnative-library-runner-ruby.h"
+#include "polyglot_scripts.h"
 
 int main(int argc, char** argv) {
   if (argc != 5) {
@@ -10,6 +11,7 @@ int main(int argc, char** argv) {
   }
 
   graal_isolatethread_t* thread = create_isolate();
+  ruby_load_kernel(thread, "Haversine", (char*)RUBY_HAVERSINE_DISTANCE);
 
   double a_lat = strtod(argv[1], NULL);
   double a_long = strtod(argv[2], NULL);
@@ -0,0 +1,27 @@
+#include <math.h>
+
+#include "wasm-export.h"
+
+static double degrees_to_radians(double degrees) {
+  return degrees * (M_PI / 180.0L);
+}
+
+static double radians_to_degrees(double radians) {
+  return radians * (180.0L / M_PI);
+}
+
+// The initial bearing (forward azimuth) along the great circle from a to b, in
+// degrees clockwise from north.
+WASM_EXPORT("initial_bearing")
+double initial_bearing(double a_lat, double a_long, double b_lat,
+                       double b_long) {
+  double a_lat_radians = degrees_to_radians(a_lat);
+  double b_lat_radians = degrees_to_radians(b_lat);
+  double delta_long_radians = degrees_to_radians(b_long - a_long);
+
+  double y = sin(delta_long_radians) * cos(b_lat_radians);
+  double x = cos(a_lat_radians) * sin(b_lat_radians) -
+             sin(a_lat_radians) * cos(b_lat_radians) * cos(delta_long_radians);
+
+  return fmod(radians_to_degrees(atan2(y, x)) + 360, 360);
+}
@@ -0,0 +1,6 @@
+#ifndef __BEARING_H
+#define __BEARING_H
+
+double initial_bearing(double, double, double, double);
+
+#endif
\ No newline at end of file
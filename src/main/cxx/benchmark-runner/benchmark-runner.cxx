@@ -2,15 +2,22 @@
 #include <jni.h>
 #include <threads.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "benchmark-utils.h"
 #include "graal_isolate.h"
-#include "haversine.h"
+#include "isolate-shards.h"
 #include "libbenchmark-runner.h"
-#include "polyglot_scripts.h"
+#include "warmup.h"
+#include "workloads.h"
 
 graal_isolate_t* isolate = nullptr;
 graal_isolatethread_t* isolate_thread = nullptr;
@@ -25,12 +32,37 @@ jclass doubleClass;
 jmethodID doubleValueOfMethod;
 jmethodID asDoubleMethod;
 jmethodID executeMethod;
+jclass benchmarkUtilsClass;
+jmethodID threadAllocatedBytesMethod;
+jmethodID gcTimeMillisMethod;
+jclass warmupClass;
+jclass wasmClass;
+jclass boundaryClass;
+jmethodID wasmLoadMethod;
+jmethodID doubleArrayProxyMethod;
+jmethodID warmupCreateContextMethod;
+jmethodID warmupCloseContextMethod;
+jmethodID warmupAdvanceIterationMethod;
+jmethodID warmupTraceRubyKernelsMethod;
+jmethodID warmupEventCountMethod;
+jmethodID warmupEventIterationMethod;
+jmethodID warmupEventKindMethod;
+
+// The WebAssembly module containing the C++ kernels. The benchmark profile
+// defines this as the module's location in the build directory.
+#ifndef WASM_MODULE_PATH
+#define WASM_MODULE_PATH "kernels.wasm"
+#endif
 
 volatile double A_LAT = 51.507222;
 volatile double A_LONG = -0.1275;
 volatile double B_LAT = 40.7127;
 volatile double B_LONG = -74.0059;
 
+// One benchmark thread per allowed hardware thread for the sharded isolate
+// comparisons.
+static const int SHARD_THREADS = allowed_cpu_count();
+
 static void DoCEntrySetup(const benchmark::State& state) {
   if (isolate_thread == nullptr) {
 #ifdef DUMP_GRAAL_GRAPHS
@@ -67,7 +99,7 @@ static void DoCEntryTeardown(const benchmark::State& state) {
 #endif
 }
 
-static void DoJNISetup(const benchmark::State& state) {
+static void InitializeJavaVM() {
   if (jvm == nullptr) {
     JavaVMInitArgs vm_args;
     JavaVMOption* options = new JavaVMOption[1];
@@ -92,9 +124,17 @@ static void DoJNISetup(const benchmark::State& state) {
     jclass builderClass =
         env->FindClass("org/graalvm/polyglot/Context$Builder");
     jclass valueClass = env->FindClass("org/graalvm/polyglot/Value");
-    javaDistanceClass = env->FindClass("com/shopify/truffleruby/NativeLibrary");
+    javaDistanceClass =
+        env->FindClass("com/nirvdrum/truffleruby/NativeLibrary");
     rubyDistanceClass =
-        env->FindClass("com/shopify/truffleruby/NativeLibraryRuby");
+        env->FindClass("com/nirvdrum/truffleruby/NativeLibraryRuby");
+    benchmarkUtilsClass =
+        env->FindClass("com/nirvdrum/truffleruby/BenchmarkUtils");
+    warmupClass =
+        env->FindClass("com/nirvdrum/truffleruby/NativeLibraryWarmup");
+    wasmClass = env->FindClass("com/nirvdrum/truffleruby/NativeLibraryWasm");
+    boundaryClass =
+        env->FindClass("com/nirvdrum/truffleruby/NativeLibraryBoundary");
 
     // Create an empty java.lang.String[].
     jstring initialElement = env->NewStringUTF("");
@@ -105,6 +145,46 @@ static void DoJNISetup(const benchmark::State& state) {
     doubleValueOfMethod =
         env->GetStaticMethodID(doubleClass, "valueOf", "(D)Ljava/lang/Double;");
 
+    // com.nirvdrum.truffleruby.BenchmarkUtils methods.
+    threadAllocatedBytesMethod =
+        env->GetStaticMethodID(benchmarkUtilsClass, "threadAllocatedBytes",
+                               "(Lorg/graalvm/nativeimage/IsolateThread;)J");
+    gcTimeMillisMethod =
+        env->GetStaticMethodID(benchmarkUtilsClass, "gcTimeMillis",
+                               "(Lorg/graalvm/nativeimage/IsolateThread;)J");
+
+    // com.nirvdrum.truffleruby.NativeLibraryWarmup methods.
+    warmupCreateContextMethod = env->GetStaticMethodID(
+        warmupClass, "createContext",
+        "(Ljava/lang/String;Ljava/lang/String;)Lorg/graalvm/polyglot/Value;");
+    warmupCloseContextMethod =
+        env->GetStaticMethodID(warmupClass, "closeContext",
+                               "(Lorg/graalvm/nativeimage/IsolateThread;)V");
+    warmupAdvanceIterationMethod =
+        env->GetStaticMethodID(warmupClass, "advanceIteration", "()V");
+    warmupTraceRubyKernelsMethod =
+        env->GetStaticMethodID(warmupClass, "traceRubyKernels", "()V");
+    warmupEventCountMethod =
+        env->GetStaticMethodID(warmupClass, "eventCount",
+                               "(Lorg/graalvm/nativeimage/IsolateThread;)I");
+    warmupEventIterationMethod =
+        env->GetStaticMethodID(warmupClass, "eventIteration",
+                               "(Lorg/graalvm/nativeimage/IsolateThread;I)I");
+    warmupEventKindMethod =
+        env->GetStaticMethodID(warmupClass, "eventKind",
+                               "(Lorg/graalvm/nativeimage/IsolateThread;I)I");
+
+    // com.nirvdrum.truffleruby.NativeLibraryWasm methods.
+    wasmLoadMethod = env->GetStaticMethodID(
+        wasmClass, "load",
+        "(Lorg/graalvm/polyglot/Context;Ljava/lang/String;Ljava/lang/"
+        "String;)Lorg/graalvm/polyglot/Value;");
+
+    // com.nirvdrum.truffleruby.NativeLibraryBoundary methods.
+    doubleArrayProxyMethod = env->GetStaticMethodID(
+        boundaryClass, "doubleArrayProxy",
+        "([D)Lorg/graalvm/polyglot/proxy/ProxyArray;");
+
     // org.graalvm.polyglot.Context methods.
     evalMethod = env->GetMethodID(contextClass, "eval",
                                   "(Ljava/lang/String;Ljava/lang/"
@@ -142,31 +222,80 @@ static void DoJNISetup(const benchmark::State& state) {
   }
 }
 
-static void DoJNITeardown(const benchmark::State& state) {
-#ifndef REUSE_CONTEXT
+static void TearDownJavaVM() {
   if (jvm != nullptr) {
     jvm->DestroyJavaVM();
     jvm = nullptr;
     env = nullptr;
   }
+}
+
+static void DoJNISetup(const benchmark::State& state) { InitializeJavaVM(); }
+
+static void DoJNITeardown(const benchmark::State& state) {
+#ifndef REUSE_CONTEXT
+  TearDownJavaVM();
 #endif
 }
 
-static void BM_CEntryJavaDistance(benchmark::State& state, double a_lat,
+// Bytes allocated by the current thread and total GC time for the isolate (or
+// VM), sampled before and after a benchmark's timing loop.
+struct AllocationSnapshot {
+  long allocated_bytes;
+  long gc_time_millis;
+};
+
+static AllocationSnapshot TakeCEntryAllocationSnapshot(
+    graal_isolatethread_t* thread) {
+  return {(long)thread_allocated_bytes(thread), (long)gc_time_millis(thread)};
+}
+
+static AllocationSnapshot TakeJNIAllocationSnapshot() {
+  return {(long)env->CallStaticLongMethod(benchmarkUtilsClass,
+                                          threadAllocatedBytesMethod, nullptr),
+          (long)env->CallStaticLongMethod(benchmarkUtilsClass,
+                                          gcTimeMillisMethod, nullptr)};
+}
+
+static void SetAllocationCounters(benchmark::State& state,
+                                  const AllocationSnapshot& start,
+                                  const AllocationSnapshot& end) {
+  state.counters["alloc_bytes"] =
+      benchmark::Counter(end.allocated_bytes - start.allocated_bytes,
+                         benchmark::Counter::kAvgIterations);
+  state.counters["gc_ms"] = end.gc_time_millis - start.gc_time_millis;
+}
+
+static void BM_CEntryJavaDistance(benchmark::State& state,
+                                  centry_kernel_t kernel, double a_lat,
                                   double a_long, double b_lat, double b_long) {
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
   for (auto _ : state) {
-    distance(isolate_thread, a_lat, a_long, b_lat, b_long);
+    kernel(isolate_thread, a_lat, a_long, b_lat, b_long);
   }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
 }
 
-static void BM_CEntryRubyDistance(benchmark::State& state, double a_lat,
+static void BM_CEntryRubyDistance(benchmark::State& state,
+                                  const Workload* workload, double a_lat,
                                   double a_long, double b_lat, double b_long) {
+  centry_kernel_t kernel = workload->centry_ruby;
+
   // Parse and evaluate the guest code once before entering the timing loop.
-  distance_ruby(isolate_thread, a_lat, a_long, b_lat, b_long);
+  load_ruby_kernel(isolate_thread, workload);
+  kernel(isolate_thread, a_lat, a_long, b_lat, b_long);
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
 
   for (auto _ : state) {
-    distance_ruby(isolate_thread, a_lat, a_long, b_lat, b_long);
+    kernel(isolate_thread, a_lat, a_long, b_lat, b_long);
   }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
 }
 
 static void BM_CEntryPolyglotDistance(benchmark::State& state,
@@ -177,10 +306,34 @@ static void BM_CEntryPolyglotDistance(benchmark::State& state,
   distance_polyglot_no_cache(isolate_thread, (char*)language, (char*)code,
                              a_lat, a_long, b_lat, b_long);
 
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
   for (auto _ : state) {
     distance_polyglot_no_cache(isolate_thread, (char*)language, (char*)code,
                                a_lat, a_long, b_lat, b_long);
   }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
+}
+
+static void BM_CEntryPolyglotWasmDistance(benchmark::State& state,
+                                          const char* function, double a_lat,
+                                          double a_long, double b_lat,
+                                          double b_long) {
+  // Instantiate the module once before entering the timing loop.
+  distance_polyglot_wasm(isolate_thread, (char*)WASM_MODULE_PATH,
+                         (char*)function, a_lat, a_long, b_lat, b_long);
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
+  for (auto _ : state) {
+    distance_polyglot_wasm(isolate_thread, (char*)WASM_MODULE_PATH,
+                           (char*)function, a_lat, a_long, b_lat, b_long);
+  }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
 }
 
 static void BM_CEntryPolyglotDistanceNoParseCache(benchmark::State& state,
@@ -192,10 +345,15 @@ static void BM_CEntryPolyglotDistanceNoParseCache(benchmark::State& state,
   distance_polyglot_no_parse_cache(isolate_thread, (char*)language, (char*)code,
                                    a_lat, a_long, b_lat, b_long);
 
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
   for (auto _ : state) {
     distance_polyglot_no_parse_cache(isolate_thread, (char*)language,
                                      (char*)code, a_lat, a_long, b_lat, b_long);
   }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
 }
 
 static void BM_CEntryPolyglotDistanceThreadSafeParseCache(
@@ -206,11 +364,16 @@ static void BM_CEntryPolyglotDistanceThreadSafeParseCache(
                                             (char*)code, a_lat, a_long, b_lat,
                                             b_long);
 
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
   for (auto _ : state) {
     distance_polyglot_thread_safe_parse_cache(isolate_thread, (char*)language,
                                               (char*)code, a_lat, a_long, b_lat,
                                               b_long);
   }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
 }
 
 static void BM_CEntryPolyglotDistanceThreadUnsafeParseCache(
@@ -221,54 +384,400 @@ static void BM_CEntryPolyglotDistanceThreadUnsafeParseCache(
                                               (char*)code, a_lat, a_long, b_lat,
                                               b_long);
 
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
   for (auto _ : state) {
     distance_polyglot_thread_unsafe_parse_cache(isolate_thread, (char*)language,
                                                 (char*)code, a_lat, a_long,
                                                 b_lat, b_long);
   }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
 }
 
-static void BM_JNIJavaDistance(benchmark::State& state, double a_lat,
-                               double a_long, double b_lat, double b_long) {
+// Arguments for the call boundary benchmarks. The identity variants return the
+// first one.
+volatile double BOUNDARY_ARGS[16] = {1, 2,  3,  4,  5,  6,  7,  8,
+                                     9, 10, 11, 12, 13, 14, 15, 16};
+
+// Guest functions with this arity take the 16 arguments as a single array,
+// the closest the polyglot API has to passing a pointer.
+static const int POINTER_ARITY = -1;
+
+// Guest functions for measuring the fixed cost of `Value.execute`.
+struct GuestBoundaryFunction {
+  const char* name;
+  int arity;
+  const char* ruby_code;
+  const char* js_code;
+};
+
+static const GuestBoundaryFunction GUEST_BOUNDARY_FUNCTIONS[] = {
+    {"Noop (0 args)", 0, "->() { 0.0 }", "() => 0"},
+    {"Noop (4 args)", 4, "->(a, b, c, d) { 0.0 }", "(a, b, c, d) => 0"},
+    {"Noop (16 args)", 16,
+     "->(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) { 0.0 }",
+     "(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) => 0"},
+    {"Identity (4 args)", 4, "->(a, b, c, d) { a }", "(a, b, c, d) => a"},
+    {"Identity (16 args)", 16,
+     "->(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) { a }",
+     "(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) => a"},
+    {"Noop (pointer)", POINTER_ARITY, "->(values) { 0.0 }", "(values) => 0"},
+    {"Identity (pointer)", POINTER_ARITY, "->(values) { values[0] }",
+     "(values) => values[0]"},
+};
+
+static void BM_CEntryBoundary0(benchmark::State& state,
+                               decltype(&noop_0) entry) {
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(entry(isolate_thread));
+  }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
+}
+
+static void BM_CEntryBoundary4(benchmark::State& state,
+                               decltype(&noop_4) entry) {
+  double a[4];
+  std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 4, a);
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(entry(isolate_thread, a[0], a[1], a[2], a[3]));
+  }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
+}
+
+static void BM_CEntryBoundary16(benchmark::State& state,
+                                decltype(&noop_16) entry) {
+  double a[16];
+  std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 16, a);
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(entry(isolate_thread, a[0], a[1], a[2], a[3],
+                                   a[4], a[5], a[6], a[7], a[8], a[9], a[10],
+                                   a[11], a[12], a[13], a[14], a[15]));
+  }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
+}
+
+static void BM_CEntryBoundaryPointer(benchmark::State& state,
+                                     decltype(&noop_pointer) entry) {
+  double a[16];
+  std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 16, a);
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(entry(isolate_thread, a));
+  }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
+}
+
+static void BM_CEntryPolyglotExecute(benchmark::State& state,
+                                     const char* language, const char* code,
+                                     int arity) {
+  double a[16];
+  std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 16, a);
+
+  // Parse and evaluate the guest code once before entering the timing loop.
+  auto function =
+      polyglot_prepare(isolate_thread, (char*)language, (char*)code);
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(isolate_thread);
+
+  // Each case calls the function once before entering the timing loop, so the
+  // first call's setup isn't timed.
+  switch (arity) {
+    case 0:
+      polyglot_execute_0(isolate_thread, function);
+      for (auto _ : state) {
+        polyglot_execute_0(isolate_thread, function);
+      }
+      break;
+    case 4:
+      polyglot_execute_4(isolate_thread, function, a[0], a[1], a[2], a[3]);
+      for (auto _ : state) {
+        polyglot_execute_4(isolate_thread, function, a[0], a[1], a[2], a[3]);
+      }
+      break;
+    case 16:
+      polyglot_execute_16(isolate_thread, function, a[0], a[1], a[2], a[3],
+                          a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11],
+                          a[12], a[13], a[14], a[15]);
+      for (auto _ : state) {
+        polyglot_execute_16(isolate_thread, function, a[0], a[1], a[2], a[3],
+                            a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11],
+                            a[12], a[13], a[14], a[15]);
+      }
+      break;
+    case POINTER_ARITY:
+      polyglot_execute_pointer(isolate_thread, function, a, 16);
+      for (auto _ : state) {
+        polyglot_execute_pointer(isolate_thread, function, a, 16);
+      }
+      break;
+  }
+
+  SetAllocationCounters(state, start,
+                        TakeCEntryAllocationSnapshot(isolate_thread));
+
+  polyglot_release(isolate_thread, function);
+}
+
+static void BM_JNIBoundary0(benchmark::State& state, const char* method) {
+  jmethodID boundaryMethod = env->GetStaticMethodID(
+      boundaryClass, method, "(Lorg/graalvm/nativeimage/IsolateThread;)D");
+
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
+  for (auto _ : state) {
+    env->CallStaticDoubleMethod(boundaryClass, boundaryMethod, nullptr);
+  }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
+}
+
+static void BM_JNIBoundary4(benchmark::State& state, const char* method) {
+  jmethodID boundaryMethod = env->GetStaticMethodID(
+      boundaryClass, method, "(Lorg/graalvm/nativeimage/IsolateThread;DDDD)D");
+  double a[4];
+  std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 4, a);
+
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
+  for (auto _ : state) {
+    env->CallStaticDoubleMethod(boundaryClass, boundaryMethod, nullptr, a[0],
+                                a[1], a[2], a[3]);
+  }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
+}
+
+static void BM_JNIBoundary16(benchmark::State& state, const char* method) {
+  jmethodID boundaryMethod = env->GetStaticMethodID(
+      boundaryClass, method,
+      "(Lorg/graalvm/nativeimage/IsolateThread;DDDDDDDDDDDDDDDD)D");
+  double a[16];
+  std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 16, a);
+
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
+  for (auto _ : state) {
+    env->CallStaticDoubleMethod(boundaryClass, boundaryMethod, nullptr, a[0],
+                                a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8],
+                                a[9], a[10], a[11], a[12], a[13], a[14], a[15]);
+  }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
+}
+
+static void BM_JNIBoundaryReference(benchmark::State& state,
+                                    const char* method) {
+  jmethodID boundaryMethod = env->GetStaticMethodID(
+      boundaryClass, method, "(Lorg/graalvm/nativeimage/IsolateThread;[D)D");
+  double a[16];
+  std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 16, a);
+
+  jdoubleArray values = env->NewDoubleArray(16);
+  env->SetDoubleArrayRegion(values, 0, 16, a);
+
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
+  for (auto _ : state) {
+    env->CallStaticDoubleMethod(boundaryClass, boundaryMethod, nullptr,
+                                values);
+  }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
+}
+
+static void BM_JNIPolyglotExecute(benchmark::State& state,
+                                  const char* language, const char* code,
+                                  int arity) {
+  jobject truffle_function =
+      env->CallObjectMethod(context, evalMethod, env->NewStringUTF(language),
+                            env->NewStringUTF(code));
+  CHECK_EXCEPTION(env);
+
+  jobjectArray args;
+  if (arity == POINTER_ARITY) {
+    double a[16];
+    std::copy(BOUNDARY_ARGS, BOUNDARY_ARGS + 16, a);
+
+    jdoubleArray values = env->NewDoubleArray(16);
+    env->SetDoubleArrayRegion(values, 0, 16, a);
+
+    args = env->NewObjectArray(1, env->FindClass("java/lang/Object"), 0);
+    env->SetObjectArrayElement(
+        args, 0,
+        env->CallStaticObjectMethod(boundaryClass, doubleArrayProxyMethod,
+                                    values));
+  } else {
+    args = env->NewObjectArray(arity, doubleClass, 0);
+    for (int i = 0; i < arity; i++) {
+      env->SetObjectArrayElement(
+          args, i,
+          env->CallStaticObjectMethod(doubleClass, doubleValueOfMethod,
+                                      (double)BOUNDARY_ARGS[i]));
+    }
+  }
+
+  // Call the function once before entering the timing loop.
+  jobject truffle_result =
+      env->CallObjectMethod(truffle_function, executeMethod, args);
+  CHECK_EXCEPTION(env);
+  env->CallDoubleMethod(truffle_result, asDoubleMethod);
+
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
+  for (auto _ : state) {
+    jobject truffle_result =
+        env->CallObjectMethod(truffle_function, executeMethod, args);
+    CHECK_EXCEPTION(env);
+    env->CallDoubleMethod(truffle_result, asDoubleMethod);
+  }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
+}
+
+// The benchmark library sums each thread's counters. That gives the right
+// bytes per iteration, but every thread attached to a shard sees the same GC
+// time, so `gc_ms` is averaged over the threads instead.
+static void SetShardedAllocationCounters(benchmark::State& state,
+                                         const AllocationSnapshot& start,
+                                         const AllocationSnapshot& end) {
+  SetAllocationCounters(state, start, end);
+  state.counters["gc_ms"].flags = benchmark::Counter::kAvgThreads;
+}
+
+static void DoShardedSetup(const benchmark::State& state) {
+  create_isolate_shards(state.range(0));
+}
+
+static void DoShardedTeardown(const benchmark::State& state) {
+  tear_down_isolate_shards();
+}
+
+static void BM_ShardedJavaDistance(benchmark::State& state,
+                                   centry_kernel_t kernel, double a_lat,
+                                   double a_long, double b_lat,
+                                   double b_long) {
+  graal_isolatethread_t* thread =
+      attach_isolate_shard(state.thread_index(), state.threads());
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(thread);
+
+  for (auto _ : state) {
+    kernel(thread, a_lat, a_long, b_lat, b_long);
+  }
+
+  SetShardedAllocationCounters(state, start,
+                               TakeCEntryAllocationSnapshot(thread));
+
+  detach_isolate_shard(thread);
+}
+
+static void BM_ShardedPolyglotDistanceThreadSafeParseCache(
+    benchmark::State& state, const char* language, const char* code,
+    double a_lat, double a_long, double b_lat, double b_long) {
+  graal_isolatethread_t* thread =
+      attach_isolate_shard(state.thread_index(), state.threads());
+
+  // Parse and evaluate the guest code once before entering the timing loop.
+  distance_polyglot_thread_safe_parse_cache(thread, (char*)language,
+                                            (char*)code, a_lat, a_long, b_lat,
+                                            b_long);
+
+  AllocationSnapshot start = TakeCEntryAllocationSnapshot(thread);
+
+  for (auto _ : state) {
+    distance_polyglot_thread_safe_parse_cache(thread, (char*)language,
+                                              (char*)code, a_lat, a_long, b_lat,
+                                              b_long);
+  }
+
+  SetShardedAllocationCounters(state, start,
+                               TakeCEntryAllocationSnapshot(thread));
+
+  detach_isolate_shard(thread);
+}
+
+// The JNI counterpart of `load_ruby_kernel`. Looking the method up initializes
+// `NativeLibraryRuby` and its Ruby context, so it's only done by the Ruby
+// backends.
+static void LoadJNIRubyKernel(const Workload* workload) {
+  jmethodID loadKernelMethod =
+      env->GetStaticMethodID(rubyDistanceClass, "loadKernel",
+                             "(Ljava/lang/String;Ljava/lang/String;)V");
+
+  env->CallStaticVoidMethod(rubyDistanceClass, loadKernelMethod,
+                            env->NewStringUTF(workload->name),
+                            env->NewStringUTF(workload->ruby_code));
+  CHECK_EXCEPTION(env);
+}
+
+static void BM_JNIJavaDistance(benchmark::State& state, const char* method,
+                               double a_lat, double a_long, double b_lat,
+                               double b_long) {
   jmethodID javaDistanceMethod =
-      env->GetStaticMethodID(javaDistanceClass, "distance",
+      env->GetStaticMethodID(javaDistanceClass, method,
                              "(Lorg/graalvm/nativeimage/IsolateThread;DDDD)D");
 
   // Parse and evaluate the guest code once before entering the timing loop.
   env->CallStaticDoubleMethod(javaDistanceClass, javaDistanceMethod, nullptr,
                               a_lat, a_long, b_lat, b_long);
 
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
   for (auto _ : state) {
     env->CallStaticDoubleMethod(javaDistanceClass, javaDistanceMethod, nullptr,
                                 a_lat, a_long, b_lat, b_long);
   }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
 }
 
-static void BM_JNIRubyDistance(benchmark::State& state, double a_lat,
+static void BM_JNIRubyDistance(benchmark::State& state,
+                               const Workload* workload, double a_lat,
                                double a_long, double b_lat, double b_long) {
   jmethodID rubyDistanceMethod =
-      env->GetStaticMethodID(rubyDistanceClass, "distance",
+      env->GetStaticMethodID(rubyDistanceClass, workload->jni_ruby_method,
                              "(Lorg/graalvm/nativeimage/IsolateThread;DDDD)D");
 
   // Parse and evaluate the guest code once before entering the timing loop.
+  LoadJNIRubyKernel(workload);
   env->CallStaticDoubleMethod(rubyDistanceClass, rubyDistanceMethod, nullptr,
                               a_lat, a_long, b_lat, b_long);
 
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
   for (auto _ : state) {
     env->CallStaticDoubleMethod(rubyDistanceClass, rubyDistanceMethod, nullptr,
                                 a_lat, a_long, b_lat, b_long);
   }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
 }
 
-static void BM_JNIPolyglotDistance(benchmark::State& state,
-                                   const char* language, const char* code,
-                                   double a_lat, double a_long, double b_lat,
+// Benchmarks calling `Value.execute` on a guest function via JNI.
+static void RunJNIPolyglotDistance(benchmark::State& state,
+                                   jobject truffle_distance, double a_lat,
+                                   double a_long, double b_lat,
                                    double b_long) {
-  jobject truffle_distance =
-      env->CallObjectMethod(context, evalMethod, env->NewStringUTF(language),
-                            env->NewStringUTF(code));
-  CHECK_EXCEPTION(env);
-
   jobjectArray distanceArgs = env->NewObjectArray(4, doubleClass, 0);
   env->SetObjectArrayElement(
       distanceArgs, 0,
@@ -289,104 +798,578 @@ static void BM_JNIPolyglotDistance(benchmark::State& state,
   CHECK_EXCEPTION(env);
   env->CallDoubleMethod(truffle_result, asDoubleMethod);
 
+  AllocationSnapshot start = TakeJNIAllocationSnapshot();
+
   for (auto _ : state) {
     jobject truffle_result =
         env->CallObjectMethod(truffle_distance, executeMethod, distanceArgs);
     CHECK_EXCEPTION(env);
     env->CallDoubleMethod(truffle_result, asDoubleMethod);
   }
+
+  SetAllocationCounters(state, start, TakeJNIAllocationSnapshot());
+}
+
+static void BM_JNIPolyglotDistance(benchmark::State& state,
+                                   const char* language, const char* code,
+                                   double a_lat, double a_long, double b_lat,
+                                   double b_long) {
+  jobject truffle_distance =
+      env->CallObjectMethod(context, evalMethod, env->NewStringUTF(language),
+                            env->NewStringUTF(code));
+  CHECK_EXCEPTION(env);
+
+  RunJNIPolyglotDistance(state, truffle_distance, a_lat, a_long, b_lat,
+                         b_long);
 }
 
-static void BM_CppDistance(benchmark::State& state, double a_lat, double a_long,
-                           double b_lat, double b_long) {
+static void BM_JNIPolyglotWasmDistance(benchmark::State& state,
+                                       const char* function, double a_lat,
+                                       double a_long, double b_lat,
+                                       double b_long) {
+  jobject truffle_distance = env->CallStaticObjectMethod(
+      wasmClass, wasmLoadMethod, context, env->NewStringUTF(WASM_MODULE_PATH),
+      env->NewStringUTF(function));
+  CHECK_EXCEPTION(env);
+
+  RunJNIPolyglotDistance(state, truffle_distance, a_lat, a_long, b_lat,
+                         b_long);
+}
+
+static void BM_CppDistance(benchmark::State& state, cpp_kernel_t kernel,
+                           double a_lat, double a_long, double b_lat,
+                           double b_long) {
   for (auto _ : state) {
-    haversine_distance(a_lat, a_long, b_lat, b_long);
-  }
-}
-
-BENCHMARK_CAPTURE(BM_CppDistance, placeholder, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("C++");
-
-BENCHMARK_CAPTURE(BM_CEntryJavaDistance, placeholder, A_LAT, A_LONG, B_LAT,
-                  B_LONG)
-    ->Name("@CEntryPoint: Java")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryRubyDistance, placeholder, A_LAT, A_LONG, B_LAT,
-                  B_LONG)
-    ->Name("@CEntryPoint: Ruby")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistance, placeholder, "ruby",
-                  RUBY_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (Ruby)")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistance, placeholder, "js",
-                  JS_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (JS)")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistanceNoParseCache, placeholder, "ruby",
-                  RUBY_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (Ruby) - No Parse Cache")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistanceNoParseCache, placeholder, "js",
-                  JS_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (JS) - No Parse Cache")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistanceThreadSafeParseCache, placeholder,
-                  "ruby", RUBY_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (Ruby) - Safe Parse Cache")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistanceThreadSafeParseCache, placeholder,
-                  "js", JS_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (JS) - Safe Parse Cache")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistanceThreadUnsafeParseCache, placeholder,
-                  "ruby", RUBY_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (Ruby) - Unsafe Parse Cache")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_CEntryPolyglotDistanceThreadUnsafeParseCache, placeholder,
-                  "js", JS_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("@CEntryPoint: Polyglot (JS) - Unsafe Parse Cache")
-    ->Setup(DoCEntrySetup)
-    ->Teardown(DoCEntryTeardown);
-
-BENCHMARK_CAPTURE(BM_JNIJavaDistance, placeholder, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("JNI: Java")
-    ->Setup(DoJNISetup)
-    ->Teardown(DoJNITeardown);
-
-BENCHMARK_CAPTURE(BM_JNIRubyDistance, placeholder, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("JNI: Ruby")
-    ->Setup(DoJNISetup)
-    ->Teardown(DoJNITeardown);
-
-BENCHMARK_CAPTURE(BM_JNIPolyglotDistance, placeholder, "ruby",
-                  RUBY_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("JNI: Polyglot (Ruby)")
-    ->Setup(DoJNISetup)
-    ->Teardown(DoJNITeardown);
-
-BENCHMARK_CAPTURE(BM_JNIPolyglotDistance, placeholder, "js",
-                  JS_HAVERSINE_DISTANCE, A_LAT, A_LONG, B_LAT, B_LONG)
-    ->Name("JNI: Polyglot (JS)")
-    ->Setup(DoJNISetup)
-    ->Teardown(DoJNITeardown);
-
-BENCHMARK_MAIN();
\ No newline at end of file
+    kernel(a_lat, a_long, b_lat, b_long);
+  }
+}
+
+// Every backend is registered for each workload, named "<workload>/<backend>".
+static void RegisterWorkloadBenchmarks(const Workload* workload) {
+  auto name = [workload](const char* backend) {
+    return std::string(workload->name) + "/" + backend;
+  };
+
+  benchmark::RegisterBenchmark(name("C++").c_str(), BM_CppDistance,
+                               workload->cpp, A_LAT, A_LONG, B_LAT, B_LONG);
+
+  benchmark::RegisterBenchmark(name("@CEntryPoint: Java").c_str(),
+                               BM_CEntryJavaDistance, workload->centry_java,
+                               A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(name("@CEntryPoint: Ruby").c_str(),
+                               BM_CEntryRubyDistance, workload, A_LAT, A_LONG,
+                               B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(name("@CEntryPoint: Polyglot (Ruby)").c_str(),
+                               BM_CEntryPolyglotDistance, "ruby",
+                               workload->ruby_code, A_LAT, A_LONG, B_LAT,
+                               B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(name("@CEntryPoint: Polyglot (JS)").c_str(),
+                               BM_CEntryPolyglotDistance, "js",
+                               workload->js_code, A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(
+      name("@CEntryPoint: Polyglot (Ruby) - No Parse Cache").c_str(),
+      BM_CEntryPolyglotDistanceNoParseCache, "ruby", workload->ruby_code,
+      A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(
+      name("@CEntryPoint: Polyglot (JS) - No Parse Cache").c_str(),
+      BM_CEntryPolyglotDistanceNoParseCache, "js", workload->js_code, A_LAT,
+      A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(
+      name("@CEntryPoint: Polyglot (Ruby) - Safe Parse Cache").c_str(),
+      BM_CEntryPolyglotDistanceThreadSafeParseCache, "ruby",
+      workload->ruby_code, A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(
+      name("@CEntryPoint: Polyglot (JS) - Safe Parse Cache").c_str(),
+      BM_CEntryPolyglotDistanceThreadSafeParseCache, "js", workload->js_code,
+      A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(
+      name("@CEntryPoint: Polyglot (Wasm) - Safe Parse Cache").c_str(),
+      BM_CEntryPolyglotWasmDistance, workload->wasm_function, A_LAT, A_LONG,
+      B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(
+      name("@CEntryPoint: Polyglot (Ruby) - Unsafe Parse Cache").c_str(),
+      BM_CEntryPolyglotDistanceThreadUnsafeParseCache, "ruby",
+      workload->ruby_code, A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(
+      name("@CEntryPoint: Polyglot (JS) - Unsafe Parse Cache").c_str(),
+      BM_CEntryPolyglotDistanceThreadUnsafeParseCache, "js", workload->js_code,
+      A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark(name("JNI: Java").c_str(), BM_JNIJavaDistance,
+                               workload->jni_java_method, A_LAT, A_LONG, B_LAT,
+                               B_LONG)
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+
+  benchmark::RegisterBenchmark(name("JNI: Ruby").c_str(), BM_JNIRubyDistance,
+                               workload, A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+
+  benchmark::RegisterBenchmark(name("JNI: Polyglot (Ruby)").c_str(),
+                               BM_JNIPolyglotDistance, "ruby",
+                               workload->ruby_code, A_LAT, A_LONG, B_LAT,
+                               B_LONG)
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+
+  benchmark::RegisterBenchmark(name("JNI: Polyglot (JS)").c_str(),
+                               BM_JNIPolyglotDistance, "js", workload->js_code,
+                               A_LAT, A_LONG, B_LAT, B_LONG)
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+
+  benchmark::RegisterBenchmark(name("JNI: Polyglot (Wasm)").c_str(),
+                               BM_JNIPolyglotWasmDistance,
+                               workload->wasm_function, A_LAT, A_LONG, B_LAT,
+                               B_LONG)
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+}
+
+// Measures each backend's fixed per-call overhead using entry points and guest
+// functions that do no work, named "<entry point>/<backend>".
+static void RegisterBoundaryBenchmarks() {
+  benchmark::RegisterBenchmark("Noop (0 args)/@CEntryPoint: Java",
+                               BM_CEntryBoundary0, noop_0)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+  benchmark::RegisterBenchmark("Noop (4 args)/@CEntryPoint: Java",
+                               BM_CEntryBoundary4, noop_4)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+  benchmark::RegisterBenchmark("Noop (16 args)/@CEntryPoint: Java",
+                               BM_CEntryBoundary16, noop_16)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+  benchmark::RegisterBenchmark("Identity (4 args)/@CEntryPoint: Java",
+                               BM_CEntryBoundary4, identity_4)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+  benchmark::RegisterBenchmark("Identity (16 args)/@CEntryPoint: Java",
+                               BM_CEntryBoundary16, identity_16)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+  benchmark::RegisterBenchmark("Noop (pointer)/@CEntryPoint: Java",
+                               BM_CEntryBoundaryPointer, noop_pointer)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+  benchmark::RegisterBenchmark("Identity (pointer)/@CEntryPoint: Java",
+                               BM_CEntryBoundaryPointer, identity_pointer)
+      ->Setup(DoCEntrySetup)
+      ->Teardown(DoCEntryTeardown);
+
+  benchmark::RegisterBenchmark("Noop (0 args)/JNI: Java", BM_JNIBoundary0,
+                               "noop0")
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+  benchmark::RegisterBenchmark("Noop (4 args)/JNI: Java", BM_JNIBoundary4,
+                               "noop4")
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+  benchmark::RegisterBenchmark("Noop (16 args)/JNI: Java", BM_JNIBoundary16,
+                               "noop16")
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+  benchmark::RegisterBenchmark("Identity (4 args)/JNI: Java", BM_JNIBoundary4,
+                               "identity4")
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+  benchmark::RegisterBenchmark("Identity (16 args)/JNI: Java",
+                               BM_JNIBoundary16, "identity16")
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+  benchmark::RegisterBenchmark("Noop (pointer)/JNI: Java",
+                               BM_JNIBoundaryReference, "noopReference")
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+  benchmark::RegisterBenchmark("Identity (pointer)/JNI: Java",
+                               BM_JNIBoundaryReference, "identityReference")
+      ->Setup(DoJNISetup)
+      ->Teardown(DoJNITeardown);
+
+  for (const GuestBoundaryFunction& function : GUEST_BOUNDARY_FUNCTIONS) {
+    auto name = [&function](const char* backend) {
+      return std::string(function.name) + "/" + backend;
+    };
+
+    benchmark::RegisterBenchmark(name("@CEntryPoint: Polyglot (Ruby)").c_str(),
+                                 BM_CEntryPolyglotExecute, "ruby",
+                                 function.ruby_code, function.arity)
+        ->Setup(DoCEntrySetup)
+        ->Teardown(DoCEntryTeardown);
+    benchmark::RegisterBenchmark(name("@CEntryPoint: Polyglot (JS)").c_str(),
+                                 BM_CEntryPolyglotExecute, "js",
+                                 function.js_code, function.arity)
+        ->Setup(DoCEntrySetup)
+        ->Teardown(DoCEntryTeardown);
+    benchmark::RegisterBenchmark(name("JNI: Polyglot (Ruby)").c_str(),
+                                 BM_JNIPolyglotExecute, "ruby",
+                                 function.ruby_code, function.arity)
+        ->Setup(DoJNISetup)
+        ->Teardown(DoJNITeardown);
+    benchmark::RegisterBenchmark(name("JNI: Polyglot (JS)").c_str(),
+                                 BM_JNIPolyglotExecute, "js", function.js_code,
+                                 function.arity)
+        ->Setup(DoJNISetup)
+        ->Teardown(DoJNITeardown);
+  }
+}
+
+// The sharded benchmarks run one thread per hardware thread and vary the
+// number of isolates those threads are spread across. A single shard is the
+// baseline of one isolate with every thread attached to it. Only Ruby is used
+// for the guest language because a JS context can't be entered by multiple
+// threads. These only use the Haversine workload.
+static void RegisterShardedBenchmarks() {
+  benchmark::RegisterBenchmark("Haversine/@CEntryPoint: Java - Sharded",
+                               BM_ShardedJavaDistance, HAVERSINE.centry_java,
+                               A_LAT, A_LONG, B_LAT, B_LONG)
+      ->ArgName("shards")
+      ->RangeMultiplier(2)
+      ->Range(1, SHARD_THREADS)
+      ->Threads(SHARD_THREADS)
+      ->UseRealTime()
+      ->Setup(DoShardedSetup)
+      ->Teardown(DoShardedTeardown);
+
+  benchmark::RegisterBenchmark(
+      "Haversine/@CEntryPoint: Polyglot (Ruby) - Safe Parse Cache - Sharded",
+      BM_ShardedPolyglotDistanceThreadSafeParseCache, "ruby",
+      HAVERSINE.ruby_code, A_LAT, A_LONG, B_LAT, B_LONG)
+      ->ArgName("shards")
+      ->RangeMultiplier(2)
+      ->Range(1, SHARD_THREADS)
+      ->Threads(SHARD_THREADS)
+      ->UseRealTime()
+      ->Setup(DoShardedSetup)
+      ->Teardown(DoShardedTeardown);
+}
+
+// Warmup mode records the latency of each of the first N calls into a fresh
+// isolate or context, rather than letting the benchmark library discard them.
+// `advance` runs after each timed call, outside of the timed region.
+
+template <typename F, typename G>
+static std::vector<double> RecordLatencies(long iterations, F call,
+                                           G advance) {
+  std::vector<double> latencies(iterations);
+
+  for (long i = 0; i < iterations; i++) {
+    auto start = std::chrono::steady_clock::now();
+    benchmark::DoNotOptimize(call());
+    auto end = std::chrono::steady_clock::now();
+
+    latencies[i] =
+        std::chrono::duration<double, std::nano>(end - start).count();
+    advance();
+  }
+
+  return latencies;
+}
+
+template <typename F>
+static std::vector<double> RecordLatencies(long iterations, F call) {
+  return RecordLatencies(iterations, call, [] {});
+}
+
+static graal_isolatethread_t* CreateWarmupIsolate() {
+  graal_isolate_t* warmup_isolate = nullptr;
+  graal_isolatethread_t* thread = nullptr;
+
+  if (graal_create_isolate(NULL, &warmup_isolate, &thread) != 0) {
+    std::cerr << "initialization error\n";
+    std::exit(1);
+  }
+
+  return thread;
+}
+
+static WarmupCurve WarmupCpp(long iterations) {
+  return {"C++", RecordLatencies(iterations, [] {
+            return HAVERSINE.cpp(A_LAT, A_LONG, B_LAT, B_LONG);
+          })};
+}
+
+// Used for both the Java and the embedded Ruby entry points. Ruby's context
+// is private to `NativeLibraryRuby`, so its compilations aren't traced.
+static WarmupCurve WarmupCEntryJava(long iterations) {
+  graal_isolatethread_t* thread = CreateWarmupIsolate();
+
+  WarmupCurve curve = {"@CEntryPoint: Java",
+                       RecordLatencies(iterations, [thread] {
+                         return HAVERSINE.centry_java(thread, A_LAT, A_LONG,
+                                                      B_LAT, B_LONG);
+                       })};
+
+  tear_down_isolate(thread);
+
+  return curve;
+}
+
+static void AddCEntryWarmupEvents(graal_isolatethread_t* thread,
+                                  WarmupCurve& curve) {
+  curve.traced = true;
+
+  int event_count = warmup_event_count(thread);
+  for (int i = 0; i < event_count; i++) {
+    curve.events.push_back(
+        {warmup_event_iteration(thread, i),
+         (WarmupEventKind)warmup_event_kind(thread, i)});
+  }
+}
+
+static WarmupCurve WarmupCEntryRuby(long iterations) {
+  graal_isolatethread_t* thread = CreateWarmupIsolate();
+  warmup_trace_ruby_kernels(thread);
+  load_ruby_kernel(thread, &HAVERSINE);
+
+  WarmupCurve curve = {
+      "@CEntryPoint: Ruby",
+      RecordLatencies(
+          iterations,
+          [thread] {
+            return HAVERSINE.centry_ruby(thread, A_LAT, A_LONG, B_LAT, B_LONG);
+          },
+          [thread] { warmup_advance_iteration(thread); })};
+  AddCEntryWarmupEvents(thread, curve);
+
+  warmup_close_context(thread);
+  tear_down_isolate(thread);
+
+  return curve;
+}
+
+// The `distance_polyglot_*` entry points build a new context or look the
+// function up on every call, so there is no `@CEntryPoint` benchmark that
+// matches this curve. It calls a single cached guest function instead.
+static WarmupCurve WarmupCEntryPolyglot(long iterations, const char* name,
+                                        const char* language,
+                                        const char* code) {
+  graal_isolatethread_t* thread = CreateWarmupIsolate();
+  warmup_create_context(thread, (char*)language, (char*)code);
+
+  WarmupCurve curve = {name, RecordLatencies(iterations, [thread] {
+                         return warmup_distance(thread, A_LAT, A_LONG, B_LAT,
+                                                B_LONG);
+                       })};
+  AddCEntryWarmupEvents(thread, curve);
+
+  warmup_close_context(thread);
+  tear_down_isolate(thread);
+
+  return curve;
+}
+
+static void AddJNIWarmupEvents(WarmupCurve& curve) {
+  curve.traced = true;
+
+  int event_count = env->CallStaticIntMethod(warmupClass,
+                                             warmupEventCountMethod, nullptr);
+  for (int i = 0; i < event_count; i++) {
+    curve.events.push_back(
+        {env->CallStaticIntMethod(warmupClass, warmupEventIterationMethod,
+                                  nullptr, i),
+         (WarmupEventKind)env->CallStaticIntMethod(
+             warmupClass, warmupEventKindMethod, nullptr, i)});
+  }
+}
+
+// Like the JNI benchmarks, each JNI curve creates its own VM and destroys it
+// when done.
+
+static WarmupCurve WarmupJNIJava(long iterations) {
+  InitializeJavaVM();
+
+  jmethodID distanceMethod =
+      env->GetStaticMethodID(javaDistanceClass, HAVERSINE.jni_java_method,
+                             "(Lorg/graalvm/nativeimage/IsolateThread;DDDD)D");
+
+  WarmupCurve curve = {
+      "JNI: Java", RecordLatencies(iterations, [distanceMethod] {
+        return env->CallStaticDoubleMethod(javaDistanceClass, distanceMethod,
+                                           nullptr, A_LAT, A_LONG, B_LAT,
+                                           B_LONG);
+      })};
+
+  TearDownJavaVM();
+
+  return curve;
+}
+
+static WarmupCurve WarmupJNIRuby(long iterations) {
+  InitializeJavaVM();
+
+  env->CallStaticVoidMethod(warmupClass, warmupTraceRubyKernelsMethod);
+  CHECK_EXCEPTION(env);
+  LoadJNIRubyKernel(&HAVERSINE);
+
+  jmethodID distanceMethod =
+      env->GetStaticMethodID(rubyDistanceClass, HAVERSINE.jni_ruby_method,
+                             "(Lorg/graalvm/nativeimage/IsolateThread;DDDD)D");
+
+  WarmupCurve curve = {
+      "JNI: Ruby", RecordLatencies(
+                       iterations,
+                       [distanceMethod] {
+                         return env->CallStaticDoubleMethod(
+                             rubyDistanceClass, distanceMethod, nullptr, A_LAT,
+                             A_LONG, B_LAT, B_LONG);
+                       },
+                       [] {
+                         env->CallStaticVoidMethod(
+                             warmupClass, warmupAdvanceIterationMethod);
+                       })};
+  AddJNIWarmupEvents(curve);
+
+  env->CallStaticVoidMethod(warmupClass, warmupCloseContextMethod, nullptr);
+  TearDownJavaVM();
+
+  return curve;
+}
+
+// Calls `Value.execute` in the same way as `RunJNIPolyglotDistance`, on a
+// function evaluated in a context with compilation tracing enabled.
+static WarmupCurve WarmupJNIPolyglot(long iterations, const char* name,
+                                     const char* language, const char* code) {
+  InitializeJavaVM();
+
+  jobject truffle_distance = env->CallStaticObjectMethod(
+      warmupClass, warmupCreateContextMethod, env->NewStringUTF(language),
+      env->NewStringUTF(code));
+  CHECK_EXCEPTION(env);
+
+  jobjectArray distanceArgs = env->NewObjectArray(4, doubleClass, 0);
+  double args[4] = {A_LAT, A_LONG, B_LAT, B_LONG};
+  for (int i = 0; i < 4; i++) {
+    env->SetObjectArrayElement(
+        distanceArgs, i,
+        env->CallStaticObjectMethod(doubleClass, doubleValueOfMethod, args[i]));
+  }
+
+  WarmupCurve curve = {
+      name, RecordLatencies(
+                iterations,
+                [truffle_distance, distanceArgs] {
+                  jobject truffle_result = env->CallObjectMethod(
+                      truffle_distance, executeMethod, distanceArgs);
+                  CHECK_EXCEPTION(env);
+                  return env->CallDoubleMethod(truffle_result, asDoubleMethod);
+                },
+                [] {
+                  env->CallStaticVoidMethod(warmupClass,
+                                            warmupAdvanceIterationMethod);
+                })};
+  AddJNIWarmupEvents(curve);
+
+  env->CallStaticVoidMethod(warmupClass, warmupCloseContextMethod, nullptr);
+  TearDownJavaVM();
+
+  return curve;
+}
+
+static void RunWarmupCurves(long iterations, const char* out_path) {
+  std::vector<WarmupCurve> curves;
+
+  curves.push_back(WarmupCpp(iterations));
+  curves.push_back(WarmupCEntryJava(iterations));
+  curves.push_back(WarmupCEntryRuby(iterations));
+  curves.push_back(WarmupCEntryPolyglot(
+      iterations, "@CEntryPoint: Polyglot (Ruby) - Cached Function", "ruby",
+      HAVERSINE.ruby_code));
+  curves.push_back(WarmupCEntryPolyglot(
+      iterations, "@CEntryPoint: Polyglot (JS) - Cached Function", "js",
+      HAVERSINE.js_code));
+  curves.push_back(WarmupJNIJava(iterations));
+  curves.push_back(WarmupJNIRuby(iterations));
+  curves.push_back(WarmupJNIPolyglot(iterations, "JNI: Polyglot (Ruby)",
+                                     "ruby", HAVERSINE.ruby_code));
+  curves.push_back(WarmupJNIPolyglot(iterations, "JNI: Polyglot (JS)", "js",
+                                     HAVERSINE.js_code));
+
+  print_warmup_summary(curves);
+
+  if (out_path != nullptr) {
+    FILE* out = fopen(out_path, "w");
+
+    if (out == nullptr) {
+      std::cerr << "unable to open " << out_path << "\n";
+      std::exit(1);
+    }
+
+    write_warmup_timeline(out, curves);
+    fclose(out);
+  }
+}
+
+int main(int argc, char** argv) {
+  long warmup_iterations = 0;
+  const char* warmup_out = nullptr;
+
+  // Strip out the warmup options so the remaining ones can be handed to the
+  // benchmark library.
+  int remaining = 1;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--warmup_iterations=", 20) == 0) {
+      warmup_iterations = strtol(argv[i] + 20, NULL, 10);
+    } else if (strncmp(argv[i], "--warmup_out=", 13) == 0) {
+      warmup_out = argv[i] + 13;
+    } else {
+      argv[remaining++] = argv[i];
+    }
+  }
+  argc = remaining;
+
+  if (warmup_iterations > 0) {
+    RunWarmupCurves(warmup_iterations, warmup_out);
+    return 0;
+  }
+
+  for (const Workload* workload : WORKLOADS) {
+    RegisterWorkloadBenchmarks(workload);
+  }
+  RegisterBoundaryBenchmarks();
+  RegisterShardedBenchmarks();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
\ No newline at end of file
@@ -1,9 +1,12 @@
 #include <math.h>
 
+#include "wasm-export.h"
+
 static const int EARTH_RADIUS = 6371;  // in km
 
 double degrees_to_radians(double degrees) { return degrees * (M_PI / 180.0L); }
 
+WASM_EXPORT("haversine_distance")
 double haversine_distance(double a_lat, double a_long, double b_lat,
                           double b_long) {
   double a_lat_radians = degrees_to_radians(a_lat);
@@ -0,0 +1,163 @@
+#include "isolate-shards.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+static std::vector<graal_isolate_t*> shards;
+
+#ifdef __linux__
+// The CPUs benchmark threads are pinned to, in the order they're handed out.
+static std::vector<int> shard_cpus;
+
+// The benchmark library runs thread 0 on the main thread, so its original CPU
+// mask must be restored or the pinning would leak into later benchmarks.
+static thread_local cpu_set_t original_cpu_set;
+static thread_local bool pinned = false;
+
+static int read_cpu_topology(int cpu, const char* name) {
+  std::ifstream in("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                   "/topology/" + name);
+  int value = -1;
+  in >> value;
+
+  return value;
+}
+
+// Lists the CPUs this process is allowed to run on, ordered by package and
+// then by physical core. SMT siblings are usually numbered `i` and
+// `i + ncores`, so sorting by core id keeps them next to each other and a
+// contiguous block of threads ends up on neighbouring cores.
+static std::vector<int> allowed_cpus_by_topology() {
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) {
+    return {};
+  }
+
+  std::vector<std::tuple<int, int, int>> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      cpus.emplace_back(read_cpu_topology(cpu, "physical_package_id"),
+                        read_cpu_topology(cpu, "core_id"), cpu);
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+
+  std::vector<int> ret;
+  for (const auto& cpu : cpus) {
+    ret.push_back(std::get<2>(cpu));
+  }
+
+  return ret;
+}
+#endif
+
+void create_isolate_shards(int shard_count) {
+#ifdef __linux__
+  shard_cpus = allowed_cpus_by_topology();
+  if (shard_cpus.empty()) {
+    std::cerr << "warning: unable to read CPU affinity; threads will not be "
+                 "pinned\n";
+  }
+#endif
+
+  for (int i = 0; i < shard_count; i++) {
+    graal_isolate_t* isolate = nullptr;
+    graal_isolatethread_t* thread = nullptr;
+
+    if (graal_create_isolate(NULL, &isolate, &thread) != 0) {
+      std::cerr << "shard initialization error\n";
+      std::exit(1);
+    }
+
+    // Benchmark threads attach themselves to their shard, so the creating
+    // thread doesn't need to stay attached.
+    graal_detach_thread(thread);
+    shards.push_back(isolate);
+  }
+}
+
+void tear_down_isolate_shards() {
+  for (graal_isolate_t* isolate : shards) {
+    graal_isolatethread_t* thread = nullptr;
+
+    if (graal_attach_thread(isolate, &thread) != 0) {
+      std::cerr << "shard attach error\n";
+      std::exit(1);
+    }
+
+    graal_tear_down_isolate(thread);
+  }
+
+  shards.clear();
+}
+
+int allowed_cpu_count() {
+#ifdef __linux__
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0) {
+    return CPU_COUNT(&allowed);
+  }
+#endif
+
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+int isolate_shard_for_thread(int thread_index, int thread_count) {
+  return (long)thread_index * shards.size() / thread_count;
+}
+
+graal_isolatethread_t* attach_isolate_shard(int thread_index,
+                                            int thread_count) {
+#ifdef __linux__
+  if (!shard_cpus.empty() &&
+      pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                             &original_cpu_set) == 0) {
+    int cpu = shard_cpus[thread_index % shard_cpus.size()];
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+
+    pinned = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                                    &cpu_set) == 0;
+    if (!pinned) {
+      std::cerr << "warning: unable to pin thread " << thread_index
+                << " to CPU " << cpu << "\n";
+    }
+  }
+#endif
+
+  graal_isolate_t* isolate =
+      shards[isolate_shard_for_thread(thread_index, thread_count)];
+  graal_isolatethread_t* thread = nullptr;
+
+  if (graal_attach_thread(isolate, &thread) != 0) {
+    std::cerr << "shard attach error\n";
+    std::exit(1);
+  }
+
+  return thread;
+}
+
+void detach_isolate_shard(graal_isolatethread_t* thread) {
+  graal_detach_thread(thread);
+
+#ifdef __linux__
+  if (pinned) {
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                           &original_cpu_set);
+    pinned = false;
+  }
+#endif
+}
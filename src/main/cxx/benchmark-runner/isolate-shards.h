@@ -0,0 +1,31 @@
+#ifndef __ISOLATE_SHARDS_H
+#define __ISOLATE_SHARDS_H
+
+#include "graal_isolate.h"
+
+// Creates `shard_count` independent Graal isolates. Each isolate has its own
+// heap, GC, and copies of the static polyglot contexts held by the
+// `@CEntryPoint` classes, so threads routed to different shards never contend
+// with each other.
+void create_isolate_shards(int shard_count);
+
+void tear_down_isolate_shards();
+
+// The number of logical CPUs (hardware threads) this process is allowed to run
+// on. Unlike `std::thread::hardware_concurrency`, this respects the affinity
+// mask on Linux.
+int allowed_cpu_count();
+
+// Maps a benchmark thread to a shard. Threads are assigned in contiguous
+// blocks so that neighbouring threads (and, with pinning, neighbouring cores)
+// share a shard.
+int isolate_shard_for_thread(int thread_index, int thread_count);
+
+// Pins the calling thread to one of the process's allowed CPUs (on Linux) and
+// attaches it to the shard selected by `isolate_shard_for_thread`. Must be
+// paired with `detach_isolate_shard` on the same thread.
+graal_isolatethread_t* attach_isolate_shard(int thread_index, int thread_count);
+
+void detach_isolate_shard(graal_isolatethread_t* thread);
+
+#endif
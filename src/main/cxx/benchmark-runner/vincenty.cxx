@@ -0,0 +1,84 @@
+#include <math.h>
+
+#include "wasm-export.h"
+
+// WGS-84 ellipsoid.
+static const double SEMI_MAJOR_AXIS = 6378137.0;  // in m
+static const double FLATTENING = 1 / 298.257223563;
+static const double SEMI_MINOR_AXIS = (1 - FLATTENING) * SEMI_MAJOR_AXIS;
+
+static const int MAX_ITERATIONS = 200;
+static const double CONVERGENCE_THRESHOLD = 1e-12;
+
+static double degrees_to_radians(double degrees) {
+  return degrees * (M_PI / 180.0L);
+}
+
+// Vincenty's inverse formula. Returns NaN if the iteration fails to converge,
+// which can happen for nearly antipodal points.
+WASM_EXPORT("vincenty_distance")
+double vincenty_distance(double a_lat, double a_long, double b_lat,
+                         double b_long) {
+  double l = degrees_to_radians(b_long - a_long);
+  double u1 = atan((1 - FLATTENING) * tan(degrees_to_radians(a_lat)));
+  double u2 = atan((1 - FLATTENING) * tan(degrees_to_radians(b_lat)));
+  double sin_u1 = sin(u1), cos_u1 = cos(u1);
+  double sin_u2 = sin(u2), cos_u2 = cos(u2);
+
+  double lambda = l;
+  double sin_sigma, cos_sigma, sigma, cos_sq_alpha, cos_2_sigma_m;
+
+  for (int i = 0;; i++) {
+    if (i == MAX_ITERATIONS) {
+      return NAN;
+    }
+
+    double sin_lambda = sin(lambda), cos_lambda = cos(lambda);
+    sin_sigma = sqrt(pow(cos_u2 * sin_lambda, 2) +
+                     pow(cos_u1 * sin_u2 - sin_u1 * cos_u2 * cos_lambda, 2));
+
+    // Coincident points.
+    if (sin_sigma == 0) {
+      return 0;
+    }
+
+    cos_sigma = sin_u1 * sin_u2 + cos_u1 * cos_u2 * cos_lambda;
+    sigma = atan2(sin_sigma, cos_sigma);
+    double sin_alpha = cos_u1 * cos_u2 * sin_lambda / sin_sigma;
+    cos_sq_alpha = 1 - sin_alpha * sin_alpha;
+
+    // Both points are on the equator.
+    cos_2_sigma_m =
+        cos_sq_alpha != 0 ? cos_sigma - 2 * sin_u1 * sin_u2 / cos_sq_alpha : 0;
+
+    double c = FLATTENING / 16 * cos_sq_alpha *
+               (4 + FLATTENING * (4 - 3 * cos_sq_alpha));
+    double previous_lambda = lambda;
+    double correction =
+        cos_2_sigma_m +
+        c * cos_sigma * (-1 + 2 * cos_2_sigma_m * cos_2_sigma_m);
+    lambda = l + (1 - c) * FLATTENING * sin_alpha *
+                     (sigma + c * sin_sigma * correction);
+
+    if (fabs(lambda - previous_lambda) < CONVERGENCE_THRESHOLD) {
+      break;
+    }
+  }
+
+  double u_sq = cos_sq_alpha *
+                (SEMI_MAJOR_AXIS * SEMI_MAJOR_AXIS -
+                 SEMI_MINOR_AXIS * SEMI_MINOR_AXIS) /
+                (SEMI_MINOR_AXIS * SEMI_MINOR_AXIS);
+  double a =
+      1 + u_sq / 16384 * (4096 + u_sq * (-768 + u_sq * (320 - 175 * u_sq)));
+  double b = u_sq / 1024 * (256 + u_sq * (-128 + u_sq * (74 - 47 * u_sq)));
+  double delta_sigma =
+      b * sin_sigma *
+      (cos_2_sigma_m +
+       b / 4 *
+           (cos_sigma * (-1 + 2 * cos_2_sigma_m * cos_2_sigma_m) -
+            b / 6 * cos_2_sigma_m * (-3 + 4 * sin_sigma * sin_sigma) *
+                (-3 + 4 * cos_2_sigma_m * cos_2_sigma_m)));
+
+  return SEMI_MINOR_AXIS * a * (sigma - delta_sigma) / 1000;  // in km
+}
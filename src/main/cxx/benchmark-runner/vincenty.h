@@ -0,0 +1,6 @@
+#ifndef __VINCENTY_H
+#define __VINCENTY_H
+
+double vincenty_distance(double, double, double, double);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "warmup.h"
+
+#include <algorithm>
+
+static double median(std::vector<double>::const_iterator begin,
+                     std::vector<double>::const_iterator end) {
+  std::vector<double> sorted(begin, end);
+  std::sort(sorted.begin(), sorted.end());
+
+  return sorted[sorted.size() / 2];
+}
+
+SteadyState find_steady_state(const std::vector<double>& latencies,
+                              double tolerance) {
+  if (latencies.empty()) {
+    return {0, 0, 0};
+  }
+
+  long count = latencies.size();
+  long tail = std::max(1L, count / 10);
+  long window = std::max(1L, count / 100);
+  double steady_latency = median(latencies.end() - tail, latencies.end());
+  double threshold = steady_latency * (1 + tolerance);
+
+  long steady_iteration = 0;
+  for (long start = 0; start < count; start += window) {
+    long end = std::min(count, start + window);
+
+    if (median(latencies.begin() + start, latencies.begin() + end) >
+        threshold) {
+      steady_iteration = end;
+    }
+  }
+
+  double elapsed = 0;
+  for (long i = 0; i < steady_iteration; i++) {
+    elapsed += latencies[i];
+  }
+
+  return {steady_iteration, elapsed, steady_latency};
+}
+
+void print_warmup_summary(const std::vector<WarmupCurve>& curves) {
+  printf("%-48s %12s %16s %16s %8s %8s\n", "Backend", "Warmup iters",
+         "Time to steady", "Steady latency", "Compiles", "Deopts");
+
+  for (const WarmupCurve& curve : curves) {
+    SteadyState steady = find_steady_state(curve.latencies);
+
+    long compilations = 0;
+    long deoptimizations = 0;
+    for (const WarmupEvent& event : curve.events) {
+      if (event.kind == COMPILATION) {
+        compilations++;
+      } else {
+        deoptimizations++;
+      }
+    }
+
+    printf("%-48s %12ld %13.3f ms %13.0f ns ", curve.backend.c_str(),
+           steady.iteration, steady.elapsed_ns / 1e6, steady.latency_ns);
+
+    if (curve.traced) {
+      printf("%8ld %8ld\n", compilations, deoptimizations);
+    } else {
+      printf("%8s %8s\n", "-", "-");
+    }
+  }
+}
+
+void write_warmup_timeline(FILE* out, const std::vector<WarmupCurve>& curves) {
+  fprintf(out, "backend,iteration,latency_ns,compilations,deoptimizations\n");
+
+  for (const WarmupCurve& curve : curves) {
+    std::vector<int> compilations(curve.latencies.size());
+    std::vector<int> deoptimizations(curve.latencies.size());
+
+    for (const WarmupEvent& event : curve.events) {
+      // Compilations finishing after the last iteration are not on the
+      // timeline.
+      if (event.iteration >= (long)curve.latencies.size()) {
+        continue;
+      }
+
+      if (event.kind == COMPILATION) {
+        compilations[event.iteration]++;
+      } else {
+        deoptimizations[event.iteration]++;
+      }
+    }
+
+    for (size_t i = 0; i < curve.latencies.size(); i++) {
+      fprintf(out, "\"%s\",%zu,%.0f,", curve.backend.c_str(), i,
+              curve.latencies[i]);
+
+      // Leave the event counts empty for curves that weren't traced, rather
+      // than reporting zero compilations.
+      if (curve.traced) {
+        fprintf(out, "%d,%d\n", compilations[i], deoptimizations[i]);
+      } else {
+        fprintf(out, ",\n");
+      }
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef __WARMUP_H
+#define __WARMUP_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Kinds of Truffle events marked on a warmup timeline. The values match the
+// constants in `NativeLibraryWarmup`.
+enum WarmupEventKind { COMPILATION = 0, DEOPTIMIZATION = 1 };
+
+struct WarmupEvent {
+  long iteration;
+  WarmupEventKind kind;
+};
+
+struct WarmupCurve {
+  std::string backend;
+  std::vector<double> latencies;  // in ns, one per iteration
+  std::vector<WarmupEvent> events;
+  bool traced = false;  // whether compilation events were recorded
+};
+
+struct SteadyState {
+  long iteration;     // first iteration considered to be at steady state
+  double elapsed_ns;  // total time spent in the iterations before it
+  double latency_ns;  // median latency at steady state
+};
+
+// The steady-state latency is the median of the final 10% of iterations. A
+// curve reaches steady state after the last window of iterations whose median
+// latency is more than `tolerance` above that.
+SteadyState find_steady_state(const std::vector<double>& latencies,
+                              double tolerance = 0.1);
+
+void print_warmup_summary(const std::vector<WarmupCurve>& curves);
+
+// Writes one CSV row per iteration with its latency and the number of
+// compilation and deoptimization events observed during it.
+void write_warmup_timeline(FILE* out, const std::vector<WarmupCurve>& curves);
+
+#endif
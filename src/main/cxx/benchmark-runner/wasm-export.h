@@ -0,0 +1,12 @@
+#ifndef __WASM_EXPORT_H
+#define __WASM_EXPORT_H
+
+// Exports a kernel from the WebAssembly module under an unmangled name. It
+// has no effect when compiling for the native target.
+#ifdef __wasm__
+#define WASM_EXPORT(name) __attribute__((export_name(name)))
+#else
+#define WASM_EXPORT(name)
+#endif
+
+#endif
\ No newline at end of file
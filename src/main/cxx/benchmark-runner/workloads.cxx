@@ -0,0 +1,44 @@
+#include "workloads.h"
+
+#include "bearing.h"
+#include "haversine.h"
+#include "libbenchmark-runner.h"
+#include "polyglot_scripts.h"
+#include "vincenty.h"
+
+const Workload HAVERSINE = {"Haversine",
+                            haversine_distance,
+                            distance,
+                            distance_ruby,
+                            "distance",
+                            "distance",
+                            RUBY_HAVERSINE_DISTANCE,
+                            JS_HAVERSINE_DISTANCE,
+                            "haversine_distance"};
+
+const Workload VINCENTY = {"Vincenty",
+                           vincenty_distance,
+                           vincenty,
+                           vincenty_ruby,
+                           "vincentyDistance",
+                           "vincentyDistance",
+                           RUBY_VINCENTY_DISTANCE,
+                           JS_VINCENTY_DISTANCE,
+                           "vincenty_distance"};
+
+const Workload INITIAL_BEARING = {"Initial Bearing",
+                                  initial_bearing,
+                                  bearing,
+                                  bearing_ruby,
+                                  "initialBearing",
+                                  "initialBearing",
+                                  RUBY_INITIAL_BEARING,
+                                  JS_INITIAL_BEARING,
+                                  "initial_bearing"};
+
+const std::vector<const Workload*> WORKLOADS = {&HAVERSINE, &VINCENTY,
+                                                &INITIAL_BEARING};
+
+void load_ruby_kernel(graal_isolatethread_t* thread, const Workload* workload) {
+  ruby_load_kernel(thread, (char*)workload->name, (char*)workload->ruby_code);
+}
@@ -0,0 +1,41 @@
+#ifndef __WORKLOADS_H
+#define __WORKLOADS_H
+
+#include <vector>
+
+#include "graal_isolate.h"
+
+typedef double (*cpp_kernel_t)(double, double, double, double);
+typedef double (*centry_kernel_t)(graal_isolatethread_t*, double, double,
+                                  double, double);
+
+// A workload is a single kernel implemented once per backend. Every workload
+// in `WORKLOADS` is registered with each of the benchmark runner's backends,
+// so adding a kernel only requires adding an entry here along with its
+// implementations.
+struct Workload {
+  const char* name;
+  cpp_kernel_t cpp;
+  centry_kernel_t centry_java;
+  centry_kernel_t centry_ruby;
+  // Static methods on `NativeLibrary` and `NativeLibraryRuby` called via JNI.
+  const char* jni_java_method;
+  const char* jni_ruby_method;
+  const char* ruby_code;
+  const char* js_code;
+  // Name the C++ kernel is exported under in the WebAssembly module.
+  const char* wasm_function;
+};
+
+extern const Workload HAVERSINE;
+extern const Workload VINCENTY;
+extern const Workload INITIAL_BEARING;
+
+extern const std::vector<const Workload*> WORKLOADS;
+
+// `NativeLibraryRuby` doesn't have its own copy of the Ruby kernels, so a
+// workload's `ruby_code` must be loaded into an isolate, under the workload's
+// name, before calling its `centry_ruby` entry point.
+void load_ruby_kernel(graal_isolatethread_t* thread, const Workload* workload);
+
+#endif
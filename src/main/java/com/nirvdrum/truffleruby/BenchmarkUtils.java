@@ -0,0 +1,29 @@
+package com.nirvdrum.truffleruby;
+
+import com.sun.management.ThreadMXBean;
+import org.graalvm.nativeimage.IsolateThread;
+import org.graalvm.nativeimage.c.function.CEntryPoint;
+
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+
+public class BenchmarkUtils {
+    private static final ThreadMXBean threadMXBean = (ThreadMXBean) ManagementFactory.getThreadMXBean();
+
+    @CEntryPoint(name = "thread_allocated_bytes")
+    public static long threadAllocatedBytes(IsolateThread thread) {
+        return threadMXBean.getCurrentThreadAllocatedBytes();
+    }
+
+    @CEntryPoint(name = "gc_time_millis")
+    public static long gcTimeMillis(IsolateThread thread) {
+        long total = 0;
+
+        for (GarbageCollectorMXBean gc : ManagementFactory.getGarbageCollectorMXBeans()) {
+            // A collector reports -1 if its collection time is unavailable.
+            total += Math.max(0, gc.getCollectionTime());
+        }
+
+        return total;
+    }
+}
@@ -0,0 +1,83 @@
+package com.nirvdrum.truffleruby;
+
+public class Geodesy {
+    // WGS-84 ellipsoid.
+    private static final double SEMI_MAJOR_AXIS = 6378137.0; // in m
+    private static final double FLATTENING = 1 / 298.257223563;
+    private static final double SEMI_MINOR_AXIS = (1 - FLATTENING) * SEMI_MAJOR_AXIS;
+
+    private static final int MAX_ITERATIONS = 200;
+    private static final double CONVERGENCE_THRESHOLD = 1e-12;
+
+    /**
+     * Vincenty's inverse formula, in km. Returns NaN if the iteration fails to converge, which can happen for nearly
+     * antipodal points.
+     */
+    public static double getVincentyDistance(double aLat, double aLong, double bLat, double bLong) {
+        final double l = Math.toRadians(bLong - aLong);
+        final double u1 = Math.atan((1 - FLATTENING) * Math.tan(Math.toRadians(aLat)));
+        final double u2 = Math.atan((1 - FLATTENING) * Math.tan(Math.toRadians(bLat)));
+        final double sinU1 = Math.sin(u1), cosU1 = Math.cos(u1);
+        final double sinU2 = Math.sin(u2), cosU2 = Math.cos(u2);
+
+        double lambda = l;
+        double sinSigma, cosSigma, sigma, cosSqAlpha, cos2SigmaM;
+
+        for (int i = 0; ; i++) {
+            if (i == MAX_ITERATIONS) {
+                return Double.NaN;
+            }
+
+            final double sinLambda = Math.sin(lambda), cosLambda = Math.cos(lambda);
+            sinSigma = Math.sqrt(Math.pow(cosU2 * sinLambda, 2) +
+                    Math.pow(cosU1 * sinU2 - sinU1 * cosU2 * cosLambda, 2));
+
+            // Coincident points.
+            if (sinSigma == 0) {
+                return 0;
+            }
+
+            cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+            sigma = Math.atan2(sinSigma, cosSigma);
+            final double sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+            cosSqAlpha = 1 - sinAlpha * sinAlpha;
+
+            // Both points are on the equator.
+            cos2SigmaM = cosSqAlpha != 0 ? cosSigma - 2 * sinU1 * sinU2 / cosSqAlpha : 0;
+
+            final double c = FLATTENING / 16 * cosSqAlpha * (4 + FLATTENING * (4 - 3 * cosSqAlpha));
+            final double previousLambda = lambda;
+            lambda = l + (1 - c) * FLATTENING * sinAlpha *
+                    (sigma + c * sinSigma * (cos2SigmaM + c * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+
+            if (Math.abs(lambda - previousLambda) < CONVERGENCE_THRESHOLD) {
+                break;
+            }
+        }
+
+        final double uSq = cosSqAlpha * (SEMI_MAJOR_AXIS * SEMI_MAJOR_AXIS - SEMI_MINOR_AXIS * SEMI_MINOR_AXIS) /
+                (SEMI_MINOR_AXIS * SEMI_MINOR_AXIS);
+        final double a = 1 + uSq / 16384 * (4096 + uSq * (-768 + uSq * (320 - 175 * uSq)));
+        final double b = uSq / 1024 * (256 + uSq * (-128 + uSq * (74 - 47 * uSq)));
+        final double deltaSigma = b * sinSigma * (cos2SigmaM + b / 4 *
+                (cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM) -
+                        b / 6 * cos2SigmaM * (-3 + 4 * sinSigma * sinSigma) * (-3 + 4 * cos2SigmaM * cos2SigmaM)));
+
+        return SEMI_MINOR_AXIS * a * (sigma - deltaSigma) / 1000;
+    }
+
+    /**
+     * The initial bearing (forward azimuth) along the great circle from a to b, in degrees clockwise from north.
+     */
+    public static double getInitialBearing(double aLat, double aLong, double bLat, double bLong) {
+        final double aLatRadians = Math.toRadians(aLat);
+        final double bLatRadians = Math.toRadians(bLat);
+        final double deltaLongRadians = Math.toRadians(bLong - aLong);
+
+        final double y = Math.sin(deltaLongRadians) * Math.cos(bLatRadians);
+        final double x = Math.cos(aLatRadians) * Math.sin(bLatRadians) -
+                Math.sin(aLatRadians) * Math.cos(bLatRadians) * Math.cos(deltaLongRadians);
+
+        return (Math.toDegrees(Math.atan2(y, x)) + 360) % 360;
+    }
+}
@@ -15,4 +15,18 @@ public class NativeLibrary {
             double b_lat, double b_long) {
         return DistanceUtils.getHaversineDistance(a_lat, a_long, b_lat, b_long);
     }
+
+    @CEntryPoint(name = "vincenty")
+    private static double vincentyDistance(IsolateThread thread,
+            double a_lat, double a_long,
+            double b_lat, double b_long) {
+        return Geodesy.getVincentyDistance(a_lat, a_long, b_lat, b_long);
+    }
+
+    @CEntryPoint(name = "bearing")
+    private static double initialBearing(IsolateThread thread,
+            double a_lat, double a_long,
+            double b_lat, double b_long) {
+        return Geodesy.getInitialBearing(a_lat, a_long, b_lat, b_long);
+    }
 }
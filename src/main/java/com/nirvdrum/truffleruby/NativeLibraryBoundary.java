@@ -0,0 +1,179 @@
+package com.nirvdrum.truffleruby;
+
+import org.graalvm.nativeimage.IsolateThread;
+import org.graalvm.nativeimage.ObjectHandle;
+import org.graalvm.nativeimage.ObjectHandles;
+import org.graalvm.nativeimage.c.function.CEntryPoint;
+import org.graalvm.nativeimage.c.type.CCharPointer;
+import org.graalvm.nativeimage.c.type.CDoublePointer;
+import org.graalvm.nativeimage.c.type.CTypeConversion;
+import org.graalvm.polyglot.Context;
+import org.graalvm.polyglot.Value;
+import org.graalvm.polyglot.proxy.ProxyArray;
+
+/**
+ * Entry points that do no work, so benchmarking them measures only the fixed cost of crossing the call boundary. The
+ * no-op variants ignore their arguments and the identity variants return the first one. Each returns a double so the
+ * JNI benchmarks can call all of them with CallStaticDoubleMethod.
+ */
+public class NativeLibraryBoundary {
+    private static final Context context = Context.newBuilder()
+            .allowExperimentalOptions(true)
+            .option("ruby.no-home-provided", "true")
+            .build();
+
+    @CEntryPoint(name = "noop_0")
+    public static double noop0(IsolateThread thread) {
+        return 0;
+    }
+
+    @CEntryPoint(name = "noop_4")
+    public static double noop4(IsolateThread thread,
+            double a, double b, double c, double d) {
+        return 0;
+    }
+
+    @CEntryPoint(name = "noop_16")
+    public static double noop16(IsolateThread thread,
+            double a, double b, double c, double d,
+            double e, double f, double g, double h,
+            double i, double j, double k, double l,
+            double m, double n, double o, double p) {
+        return 0;
+    }
+
+    @CEntryPoint(name = "identity_4")
+    public static double identity4(IsolateThread thread,
+            double a, double b, double c, double d) {
+        return a;
+    }
+
+    @CEntryPoint(name = "identity_16")
+    public static double identity16(IsolateThread thread,
+            double a, double b, double c, double d,
+            double e, double f, double g, double h,
+            double i, double j, double k, double l,
+            double m, double n, double o, double p) {
+        return a;
+    }
+
+    @CEntryPoint(name = "noop_pointer")
+    public static double noopPointer(IsolateThread thread, CDoublePointer values) {
+        return 0;
+    }
+
+    @CEntryPoint(name = "identity_pointer")
+    public static double identityPointer(IsolateThread thread, CDoublePointer values) {
+        return values.read();
+    }
+
+    // JNI counterparts of the pointer entry points.
+    public static double noopReference(IsolateThread thread, double[] values) {
+        return 0;
+    }
+
+    public static double identityReference(IsolateThread thread, double[] values) {
+        return values[0];
+    }
+
+    // The polyglot variants evaluate the guest function once and hand it back to the caller as a handle, leaving
+    // only the cost of Value.execute in the benchmark loop.
+    @CEntryPoint(name = "polyglot_prepare")
+    public static ObjectHandle prepare(IsolateThread thread, CCharPointer cLanguage, CCharPointer cCode) {
+        final String code = CTypeConversion.toJavaString(cCode);
+        final String language = CTypeConversion.toJavaString(cLanguage);
+
+        return ObjectHandles.getGlobal().create(context.eval(language, code));
+    }
+
+    @CEntryPoint(name = "polyglot_release")
+    public static void release(IsolateThread thread, ObjectHandle function) {
+        ObjectHandles.getGlobal().destroy(function);
+    }
+
+    @CEntryPoint(name = "polyglot_execute_0")
+    public static double execute0(IsolateThread thread, ObjectHandle function) {
+        final Value value = ObjectHandles.getGlobal().get(function);
+
+        return value.execute().asDouble();
+    }
+
+    @CEntryPoint(name = "polyglot_execute_4")
+    public static double execute4(IsolateThread thread, ObjectHandle function,
+            double a, double b, double c, double d) {
+        final Value value = ObjectHandles.getGlobal().get(function);
+
+        return value.execute(a, b, c, d).asDouble();
+    }
+
+    @CEntryPoint(name = "polyglot_execute_16")
+    public static double execute16(IsolateThread thread, ObjectHandle function,
+            double a, double b, double c, double d,
+            double e, double f, double g, double h,
+            double i, double j, double k, double l,
+            double m, double n, double o, double p) {
+        final Value value = ObjectHandles.getGlobal().get(function);
+
+        return value.execute(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p).asDouble();
+    }
+
+    @CEntryPoint(name = "polyglot_execute_pointer")
+    public static double executePointer(IsolateThread thread, ObjectHandle function, CDoublePointer values, int length) {
+        final Value value = ObjectHandles.getGlobal().get(function);
+
+        return value.execute(new DoublePointerProxy(values, length)).asDouble();
+    }
+
+    // Reads the caller's memory directly rather than copying it.
+    private static final class DoublePointerProxy implements ProxyArray {
+        private final CDoublePointer values;
+        private final int length;
+
+        DoublePointerProxy(CDoublePointer values, int length) {
+            this.values = values;
+            this.length = length;
+        }
+
+        @Override
+        public Object get(long index) {
+            return values.read((int) index);
+        }
+
+        @Override
+        public void set(long index, Value value) {
+            throw new UnsupportedOperationException();
+        }
+
+        @Override
+        public long getSize() {
+            return length;
+        }
+    }
+
+    public static ProxyArray doubleArrayProxy(double[] values) {
+        return new DoubleArrayProxy(values);
+    }
+
+    private static final class DoubleArrayProxy implements ProxyArray {
+        private final double[] values;
+
+        DoubleArrayProxy(double[] values) {
+            this.values = values;
+        }
+
+        @Override
+        public Object get(long index) {
+            return values[(int) index];
+        }
+
+        @Override
+        public void set(long index, Value value) {
+            throw new UnsupportedOperationException();
+        }
+
+        @Override
+        public long getSize() {
+            return values.length;
+        }
+    }
+}
@@ -2,26 +2,94 @@ package com.nirvdrum.truffleruby;
 
 import org.graalvm.nativeimage.IsolateThread;
 import org.graalvm.nativeimage.c.function.CEntryPoint;
+import org.graalvm.nativeimage.c.type.CCharPointer;
+import org.graalvm.nativeimage.c.type.CTypeConversion;
 import org.graalvm.polyglot.Context;
 import org.graalvm.polyglot.Value;
 
+import java.util.concurrent.ConcurrentHashMap;
+
 public class NativeLibraryRuby {
-    private static final Context context = Context.newBuilder()
-            .allowExperimentalOptions(true)
-            .option("ruby.no-home-provided", "true")
-            .build();
-    private static final Value haversineDistance = context.eval("ruby", PolyglotScripts.getHaversineRuby());
+    // Created on first use so the warm-up curves can substitute a context that traces compilations.
+    private static Context context;
+
+    // Evaluated Ruby kernels, keyed by workload name. The source for each kernel lives in polyglot_scripts.h, alongside
+    // the source used by the polyglot backends, so it's handed to this class by the caller.
+    private static final ConcurrentHashMap<String, Value> kernels = new ConcurrentHashMap<>();
 
     public static void main(String[] args) {
         System.out.println("You called native-library-ruby-runner with: " + args.toString());
     }
 
+    private static synchronized Context getContext() {
+        if (context == null) {
+            context = Context.newBuilder()
+                    .allowExperimentalOptions(true)
+                    .option("ruby.no-home-provided", "true")
+                    .build();
+        }
+
+        return context;
+    }
+
+    /**
+     * Replaces the context the kernels are evaluated in, discarding any kernels already loaded.
+     */
+    public static synchronized void useContext(Context newContext) {
+        context = newContext;
+        kernels.clear();
+    }
+
+    /**
+     * Evaluates the Ruby kernel for a workload, unless it has already been loaded. Must be called before the workload's
+     * entry point.
+     */
+    public static void loadKernel(String workload, String code) {
+        kernels.computeIfAbsent(workload, k -> getContext().eval("ruby", code));
+    }
+
+    @CEntryPoint(name = "ruby_load_kernel")
+    public static void loadKernel(IsolateThread thread, CCharPointer cWorkload, CCharPointer cCode) {
+        loadKernel(CTypeConversion.toJavaString(cWorkload), CTypeConversion.toJavaString(cCode));
+    }
+
+    private static Value kernel(String workload) {
+        final Value kernel = kernels.get(workload);
+
+        if (kernel == null) {
+            throw new IllegalStateException(
+                    "No Ruby kernel loaded for the " + workload + " workload; call ruby_load_kernel first");
+        }
+
+        return kernel;
+    }
+
     @CEntryPoint(name = "distance_ruby")
     public static double distance(IsolateThread thread,
             double a_lat, double a_long,
             double b_lat, double b_long) {
 
-        final Value ret = haversineDistance.execute(a_lat, a_long, b_lat, b_long);
+        final Value ret = kernel("Haversine").execute(a_lat, a_long, b_lat, b_long);
+
+        return ret.asDouble();
+    }
+
+    @CEntryPoint(name = "vincenty_ruby")
+    public static double vincentyDistance(IsolateThread thread,
+            double a_lat, double a_long,
+            double b_lat, double b_long) {
+
+        final Value ret = kernel("Vincenty").execute(a_lat, a_long, b_lat, b_long);
+
+        return ret.asDouble();
+    }
+
+    @CEntryPoint(name = "bearing_ruby")
+    public static double initialBearing(IsolateThread thread,
+            double a_lat, double a_long,
+            double b_lat, double b_long) {
+
+        final Value ret = kernel("Initial Bearing").execute(a_lat, a_long, b_lat, b_long);
 
         return ret.asDouble();
     }
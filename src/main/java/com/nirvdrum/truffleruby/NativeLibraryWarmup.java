@@ -0,0 +1,135 @@
+package com.nirvdrum.truffleruby;
+
+import org.graalvm.nativeimage.IsolateThread;
+import org.graalvm.nativeimage.c.function.CEntryPoint;
+import org.graalvm.nativeimage.c.type.CCharPointer;
+import org.graalvm.nativeimage.c.type.CTypeConversion;
+import org.graalvm.polyglot.Context;
+import org.graalvm.polyglot.Value;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.logging.Handler;
+import java.util.logging.LogRecord;
+
+public class NativeLibraryWarmup {
+    public static final int COMPILATION = 0;
+    public static final int DEOPTIMIZATION = 1;
+
+    private record Event(int iteration, int kind) {}
+
+    // Truffle compiles on background threads, so events can be published while the benchmark thread is executing.
+    private static final List<Event> events = Collections.synchronizedList(new ArrayList<>());
+    private static volatile int iteration;
+    private static Context context;
+    private static Value function;
+
+    // Turns the Truffle compilation trace into timeline events, tagged with the iteration that was running when the
+    // compiler reported them.
+    private static class CompilationEventHandler extends Handler {
+        @Override
+        public void publish(LogRecord record) {
+            final String message = record.getMessage();
+
+            if (message == null) {
+                return;
+            }
+
+            if (message.contains("opt done")) {
+                events.add(new Event(iteration, COMPILATION));
+            } else if (message.contains("opt deopt") || message.contains("opt inval")) {
+                events.add(new Event(iteration, DEOPTIMIZATION));
+            }
+        }
+
+        @Override
+        public void flush() {}
+
+        @Override
+        public void close() {}
+    }
+
+    private static void createTracedContext() {
+        closeContext(null);
+
+        events.clear();
+        iteration = 0;
+
+        context = Context.newBuilder()
+                .allowExperimentalOptions(true)
+                .option("ruby.no-home-provided", "true")
+                .option("engine.TraceCompilation", "true")
+                .logHandler(new CompilationEventHandler())
+                .build();
+    }
+
+    // Returns the guest function so JNI callers can drive it through Value.execute, the same path as the JNI polyglot
+    // benchmarks. They then call advanceIteration once per call, outside the timed region.
+    public static Value createContext(String language, String code) {
+        createTracedContext();
+        function = context.eval(language, code);
+
+        return function;
+    }
+
+    // The embedded Ruby backend runs its kernels in NativeLibraryRuby's own context, so it's handed a traced one
+    // instead. Callers drive the kernel through NativeLibraryRuby and call advanceIteration after each call.
+    public static void traceRubyKernels() {
+        createTracedContext();
+        NativeLibraryRuby.useContext(context);
+    }
+
+    @CEntryPoint(name = "warmup_trace_ruby_kernels")
+    public static void traceRubyKernels(IsolateThread thread) {
+        traceRubyKernels();
+    }
+
+    @CEntryPoint(name = "warmup_create_context")
+    public static void createContext(IsolateThread thread, CCharPointer cLanguage, CCharPointer cCode) {
+        createContext(CTypeConversion.toJavaString(cLanguage), CTypeConversion.toJavaString(cCode));
+    }
+
+    @CEntryPoint(name = "warmup_close_context")
+    public static void closeContext(IsolateThread thread) {
+        if (context != null) {
+            context.close();
+            context = null;
+            function = null;
+        }
+    }
+
+    @CEntryPoint(name = "warmup_distance")
+    public static double distance(IsolateThread thread,
+            double aLat, double aLong,
+            double bLat, double bLong) {
+        final double ret = function.execute(aLat, aLong, bLat, bLong).asDouble();
+        iteration++;
+
+        return ret;
+    }
+
+    public static void advanceIteration() {
+        iteration++;
+    }
+
+    @CEntryPoint(name = "warmup_advance_iteration")
+    public static void advanceIteration(IsolateThread thread) {
+        advanceIteration();
+    }
+
+    @CEntryPoint(name = "warmup_event_count")
+    public static int eventCount(IsolateThread thread) {
+        return events.size();
+    }
+
+    @CEntryPoint(name = "warmup_event_iteration")
+    public static int eventIteration(IsolateThread thread, int index) {
+        return events.get(index).iteration();
+    }
+
+    @CEntryPoint(name = "warmup_event_kind")
+    public static int eventKind(IsolateThread thread, int index) {
+        return events.get(index).kind();
+    }
+}
@@ -0,0 +1,63 @@
+package com.nirvdrum.truffleruby;
+
+import org.graalvm.nativeimage.IsolateThread;
+import org.graalvm.nativeimage.c.function.CEntryPoint;
+import org.graalvm.nativeimage.c.type.CCharPointer;
+import org.graalvm.nativeimage.c.type.CTypeConversion;
+import org.graalvm.polyglot.Context;
+import org.graalvm.polyglot.Source;
+import org.graalvm.polyglot.Value;
+import org.graalvm.polyglot.io.ByteSequence;
+
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.concurrent.ConcurrentHashMap;
+
+public class NativeLibraryWasm {
+    // Exported functions, keyed by module path and then by function name.
+    private static final ConcurrentHashMap<String, ConcurrentHashMap<String, Value>> functionCache =
+            new ConcurrentHashMap<>();
+    private static final Context context = Context.newBuilder("wasm").build();
+
+    /**
+     * Looks up a function exported by a WebAssembly module, instantiating the module in the context first if it hasn't
+     * been already. Modules are named after their absolute path, so different modules can be loaded into one context.
+     */
+    public static Value load(Context context, String modulePath, String functionName) {
+        final Path path = Path.of(modulePath).toAbsolutePath().normalize();
+        final String moduleName = path.toString();
+        Value module = context.getBindings("wasm").getMember(moduleName);
+
+        if (module == null) {
+            final byte[] binary;
+            try {
+                binary = Files.readAllBytes(path);
+            } catch (IOException e) {
+                throw new UncheckedIOException(e);
+            }
+
+            context.eval(Source.newBuilder("wasm", ByteSequence.create(binary), moduleName).buildLiteral());
+            module = context.getBindings("wasm").getMember(moduleName);
+        }
+
+        return module.getMember(functionName);
+    }
+
+    @CEntryPoint(name = "distance_polyglot_wasm")
+    public static double distance(IsolateThread thread,
+            CCharPointer cModulePath,
+            CCharPointer cFunctionName,
+            double aLat, double aLong,
+            double bLat, double bLong) {
+        final String modulePath = CTypeConversion.toJavaString(cModulePath);
+        final String functionName = CTypeConversion.toJavaString(cFunctionName);
+
+        var function = functionCache
+                .computeIfAbsent(modulePath, k -> new ConcurrentHashMap<>())
+                .computeIfAbsent(functionName, k -> load(context, modulePath, functionName));
+
+        return function.execute(aLat, aLong, bLat, bLong).asDouble();
+    }
+}